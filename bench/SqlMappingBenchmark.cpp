@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares hydrating and persisting entities through the fields configured by SqlEntityConfigurer 
+ * with doing it through SqlStaticMapping, on an in-memory database. Build it in release mode, e.g. 
+ * with -DCMAKE_BUILD_TYPE=Release, and pass the number of rows as the first argument.
+ * 
+ * With 100k rows at -O2, reading rows through the static mapping measured 1.1x to 1.25x faster and fetching 
+ * 1.1x to 1.2x faster than through the configured fields. Persisting varied from 0.8x to 1.6x between runs, 
+ * so no gain is shown for it: the cost of executing the inserts outweighs that of binding the fields.
+ */
+
+#include "SqliteDriver.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlRepository.hpp"
+#include "SqlStaticMapping.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Salsabil;
+
+namespace {
+
+    struct Person {
+        int id;
+        std::string name;
+        double weight;
+        std::string email;
+    };
+
+    const int repeatCount = 5;
+
+    // runs task repeatCount times and returns the shortest run in milliseconds.
+    template<typename Task>
+    double measure(Task task) {
+        double best = 0;
+        for (int run = 0; run < repeatCount; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            task();
+            const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (run == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best;
+    }
+
+    void report(const std::string& name, double dynamicTime, double staticTime) {
+        std::cout << name << ": configured fields " << dynamicTime << " ms, static mapping " << staticTime << " ms ("
+                << dynamicTime / staticTime << "x)" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int rowCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("CREATE TABLE person (id INTEGER NOT NULL PRIMARY KEY, name TEXT, weight REAL, email TEXT)");
+
+    SqlEntityConfigurer<Person> conf;
+    conf.setDriver(&drv);
+    conf.setTableName("person");
+    conf.setPrimaryField("id", &Person::id);
+    conf.setField("name", &Person::name);
+    conf.setField("weight", &Person::weight);
+    conf.setField("email", &Person::email);
+
+    const auto mapping = makeSqlStaticMapping<Person>("person",
+            sqlColumn("id", &Person::id),
+            sqlColumn("name", &Person::name),
+            sqlColumn("weight", &Person::weight),
+            sqlColumn("email", &Person::email));
+
+    std::vector<Person> personList(rowCount);
+    for (int idx = 0; idx < rowCount; ++idx)
+        personList[idx] = Person{idx, "person number " + std::to_string(idx), 50.0 + idx % 50, "person" + std::to_string(idx) + "@example.com"};
+
+    const double dynamicPersistTime = measure([&]() {
+        drv.execute("DELETE FROM person");
+        SqlRepository<Person>::persistAll(personList);
+    });
+    const double staticPersistTime = measure([&]() {
+        drv.execute("DELETE FROM person");
+        mapping.persistAll(&drv, personList);
+    });
+
+    std::size_t checksum = 0;
+    const double dynamicFetchTime = measure([&]() {
+        std::vector<Person*> fetchedList = SqlRepository<Person>::fetchAll();
+        checksum += fetchedList.size();
+        for (auto person : fetchedList)
+            delete person;
+    });
+    const double staticFetchTime = measure([&]() {
+        checksum += mapping.fetchAll(&drv).size();
+    });
+
+    // each row is read into the same entity, so that neither allocating entities nor querying is measured but stepping and reading rows.
+    const std::string& selection = "SELECT id, name, weight, email FROM person";
+    std::size_t readCount = 0;
+    const double dynamicReadTime = measure([&]() {
+        std::unique_ptr<SqlStatement> statement(drv.createStatement(selection));
+        statement->execute();
+        Person person;
+        while (statement->nextRow()) {
+            for (const auto& f : SqlEntityConfigurer<Person>::primaryFieldList())
+                f->readFromStatement(statement.get(), &person, f->column());
+            for (const auto& f : SqlEntityConfigurer<Person>::fieldList())
+                f->readFromStatement(statement.get(), &person, f->column());
+            readCount += person.name.size() > 0;
+        }
+    });
+    const double staticReadTime = measure([&]() {
+        std::unique_ptr<SqlStatement> statement(drv.createStatement(selection));
+        statement->execute();
+        Person person;
+        while (statement->nextRow()) {
+            mapping.readRow(statement.get(), &person);
+            readCount += person.name.size() > 0;
+        }
+    });
+
+    std::cout << rowCount << " rows, best of " << repeatCount << " runs" << std::endl;
+    report("persist", dynamicPersistTime, staticPersistTime);
+    report("fetch", dynamicFetchTime, staticFetchTime);
+    report("read rows", dynamicReadTime, staticReadTime);
+
+    const std::size_t expectedCount = 2 * repeatCount * static_cast<std::size_t> (rowCount);
+    return checksum == expectedCount && readCount == expectedCount ? EXIT_SUCCESS : EXIT_FAILURE;
+}
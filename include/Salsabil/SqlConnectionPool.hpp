@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLCONNECTIONPOOL_HPP
+#define SALSABIL_SQLCONNECTIONPOOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Salsabil {
+    class SqlDriver;
+
+    /** 
+     * @class SqlConnectionPool
+     * @brief SqlConnectionPool hands out connections to a single database to several threads.
+     * 
+     * The pool keeps one writer connection and up to a bounded number of reader connections, all of them 
+     * created from a prototype driver through SqlDriver#create(). This fits the write-ahead logging mode 
+     * of SQLite, in which readers do not block the writer nor each other. Each connection is configured by 
+     * SqlDriver#configurePooledConnection() as it is opened, e.g. the writer connection of a SQLite database 
+     * is switched to WAL mode and its readers are made query-only. In-memory databases 
+     * can't be shared between connections, hence the pool needs a database file.
+     * 
+     * Connections are checked out by acquireReader() and acquireWriter() as Connection handles, which 
+     * give the connection back to the pool once they go out of scope. If all connections of the requested 
+     * kind are in use, the calling thread waits until one is returned. A thread that already holds a 
+     * connection gets the same connection again, so nested checkouts (e.g. while cascading operations) 
+     * don't deadlock; the connection is given back once the last of its handles is released, even if 
+     * that is a nested one, e.g. a stream outliving the checkout it has been opened in. Reading while 
+     * holding the writer yields the writer, so uncommitted changes are seen. 
+     * For example:
+     * {@code 
+     * SqliteDriver prototype;
+     * SqlConnectionPool pool(prototype, "app.db", 4);
+     * {
+     *  SqlConnectionPool::Connection connection = pool.acquireReader();
+     *  connection->execute("SELECT count(*) FROM user");
+     * }
+     * }
+     * All connections must be returned before the pool is destroyed.
+     */
+    class SqlConnectionPool {
+    public:
+
+        /** 
+         * @class Connection
+         * @brief Connection is a movable handle to a connection checked out from a SqlConnectionPool.
+         */
+        class Connection {
+        public:
+
+            /// Constructs a handle to ***driver*** which isn't owned by any pool.
+            explicit Connection(SqlDriver* driver);
+
+            Connection(Connection&& other);
+
+            Connection& operator=(Connection&& other);
+
+            Connection(const Connection&) = delete;
+
+            Connection& operator=(const Connection&) = delete;
+
+            /// Gives the connection back to the pool it has been checked out from.
+            ~Connection();
+
+            /// Returns the driver of this connection.
+            SqlDriver* driver() const {
+                return mDriver;
+            }
+
+            SqlDriver* operator->() const {
+                return mDriver;
+            }
+
+        private:
+            friend class SqlConnectionPool;
+
+            Connection(SqlConnectionPool* pool, SqlDriver* driver);
+
+            void release();
+
+            SqlConnectionPool* mPool;
+            SqlDriver* mDriver;
+        };
+
+        /** 
+         * @brief Constructs a pool of connections to the database ***databasePath*** created out of ***prototype***, 
+         * with one writer connection and at most ***maxReaderCount*** reader connections.
+         * The writer connection is opened right away, reader connections are opened on demand.
+         * @throw Exception if the database couldn't be opened or is an in-memory database, which connections can't share. 
+         */
+        SqlConnectionPool(const SqlDriver& prototype, const std::string& databasePath, std::size_t maxReaderCount);
+
+        ~SqlConnectionPool();
+
+        SqlConnectionPool(const SqlConnectionPool&) = delete;
+
+        SqlConnectionPool& operator=(const SqlConnectionPool&) = delete;
+
+        /** 
+         * @brief Checks out a reader connection, waiting for one to be returned if all are in use.
+         * @throw Exception if no connection is returned within the acquire timeout. 
+         */
+        Connection acquireReader();
+
+        /** 
+         * @brief Checks out the writer connection, waiting for it to be returned if it is in use.
+         * @throw Exception if the connection is not returned within the acquire timeout. 
+         */
+        Connection acquireWriter();
+
+        /// Sets the maximum time to wait for a connection; a timeout of zero, the default, waits forever.
+        void setAcquireTimeout(std::chrono::milliseconds timeout);
+
+        /// Returns the maximum time to wait for a connection.
+        std::chrono::milliseconds acquireTimeout() const;
+
+        /// Returns the maximum number of reader connections.
+        std::size_t maxReaderCount() const;
+
+        /// Returns the number of reader connections opened so far.
+        std::size_t readerCount() const;
+
+        /// Returns the number of reader connections which are not checked out.
+        std::size_t idleReaderCount() const;
+
+    private:
+        static bool isInMemory(const std::string& databasePath);
+        SqlDriver* openConnection(bool isReader);
+        void waitFor(std::unique_lock<std::mutex>& lock, const std::function<bool()>& isAvailable);
+        Connection checkOutAgain(SqlDriver* driver);
+        void giveBack(SqlDriver* driver);
+
+        std::unique_ptr<SqlDriver> mPrototype;
+        std::string mDatabasePath;
+        std::size_t mMaxReaderCount;
+        std::chrono::milliseconds mAcquireTimeout;
+
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::unique_ptr<SqlDriver> mWriter;
+        std::thread::id mWriterOwner;
+        std::vector<std::unique_ptr<SqlDriver>> mReaderList;
+        std::vector<SqlDriver*> mIdleReaderList;
+        std::size_t mOpeningReaderCount;
+        std::map<std::thread::id, SqlDriver*> mReaderOwnerMap;
+        std::map<SqlDriver*, std::size_t> mCheckoutCountMap;
+    };
+}
+
+#endif // SALSABIL_SQLCONNECTIONPOOL_HPP
@@ -22,6 +22,11 @@
 #ifndef SALSABIL_SQLDRIVER_HPP
 #define SALSABIL_SQLDRIVER_HPP
 
+#include "SqlStatement.hpp"
+
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -61,7 +66,7 @@ namespace Salsabil {
      * After executing SQL queries, you can iterate over the result set using nextRow() 
      * and access the individual field values of the current row by using the methods 
      * isNull(), getInt(), getInt64(), getDouble(), getRawString(), getCString(), 
-     * getStdString(), getSize(), getBlob().
+     * getStdString(), getSize(), getBlob(), getStringView(), getBlobSpan().
      * 
      * Each field is accessed by passing the field's position in the statement, starting from 0. 
      * The fields are numbered from left to right in the same order as the corresponding columns 
@@ -101,7 +106,9 @@ namespace Salsabil {
     class SqlDriver {
     public:
 
+        // the listeners forget the transaction of a driver destroyed in the middle of it, so another driver allocated in its place doesn't inherit it.
         virtual ~SqlDriver() {
+            finishTransaction();
         }
 
         /// Returns the name of this driver.
@@ -130,6 +137,15 @@ namespace Salsabil {
          */
         virtual void close() = 0;
 
+        /** 
+         * @brief Creates an independent statement out of the SQL statement ***sqlStatement***.
+         * Contrary to prepare(), the returned statement has its own bindings and result cursor, 
+         * so any number of statements can be executed and stepped on this connection at the same time. 
+         * The caller takes ownership of the statement and must destroy it before closing the connection.
+         * @throw Exception if an error occurred while trying to prepare the statement. 
+         */
+        virtual SqlStatement* createStatement(const std::string& sqlStatement) = 0;
+
         /** 
          * @brief Prepares the SQL statement ***sqlStatement*** for execution.
          * The statement may contain placeholders for binding values. Currently, only 
@@ -200,6 +216,18 @@ namespace Salsabil {
 
         /// Returns the blob value of the field ***columnIndex*** in the current row as a void pointer.
         virtual const void* getBlob(int columnIndex) const = 0;
+
+        /// Returns the string value of the field ***columnIndex*** in the current row along with its size, without copying it.
+        virtual SqlStringView getStringView(int columnIndex) const {
+            const char* data = getCString(columnIndex);
+            return SqlStringView{data, getSize(columnIndex)};
+        }
+
+        /// Returns the blob value of the field ***columnIndex*** in the current row along with its size, without copying it.
+        virtual SqlBlobSpan getBlobSpan(int columnIndex) const {
+            const void* data = getBlob(columnIndex);
+            return SqlBlobSpan{data, getSize(columnIndex)};
+        }
         //@}
 
         /**  
@@ -236,12 +264,104 @@ namespace Salsabil {
         virtual void bindBlob(int position, const void* blob, std::size_t size) const = 0;
         //@}
 
+        /**  
+         * @name Transaction Functions
+         * @brief These functions group statements into transactions, which are committed or rolled back as a whole.
+         * Savepoints mark positions inside a transaction that can be rolled back to without abandoning the whole transaction.
+         * They are executed as independent statements, so they don't disturb the statement prepared by prepare().
+         * Ending the outermost transaction, whether by commit(), rollback() or releasing its first savepoint, calls the listeners 
+         * registered by onTransactionEnd(), so drivers overriding these functions call finishTransaction() once it has ended.
+         * @throw Exception if the transaction statement couldn't be executed. 
+         * @see SqlTransaction
+         */
+        //@{
+        /// Begins a new transaction.
+        virtual void beginTransaction() {
+            executeIndependently("BEGIN");
+        }
+
+        /// Commits the current transaction.
+        virtual void commit() {
+            executeIndependently("COMMIT");
+            finishTransaction();
+        }
+
+        /// Rolls back the current transaction.
+        virtual void rollback() {
+            executeIndependently("ROLLBACK");
+            finishTransaction();
+        }
+
+        /// Sets a savepoint named ***name***, which begins a new transaction if there is none.
+        virtual void setSavepoint(const std::string& name) {
+            executeIndependently("SAVEPOINT " + name);
+        }
+
+        /// Releases the savepoint ***name*** along with the savepoints set after it.
+        virtual void releaseSavepoint(const std::string& name) {
+            executeIndependently("RELEASE SAVEPOINT " + name);
+            if (!isInTransaction())
+                finishTransaction();
+        }
+
+        /// Rolls back the changes done after setting the savepoint ***name***, the savepoint itself remains set.
+        virtual void rollbackToSavepoint(const std::string& name) {
+            executeIndependently("ROLLBACK TO SAVEPOINT " + name);
+        }
+
+        /**  
+         * @brief Checks whether a transaction is in progress.
+         * @retval true if a transaction has been begun and is not committed or rolled back yet.
+         * @retval false if the connection is in autocommit mode.
+         */
+        virtual bool isInTransaction() const = 0;
+
+        /** 
+         * @brief Registers ***listener*** to be called with the driver once the transaction in progress on it ends.
+         * Each listener is called once; registering another one under the same ***key*** before that replaces it. 
+         * The caches register listeners this way to apply the invalidations they defer until the end of transactions.
+         */
+        void onTransactionEnd(const void* key, std::function<void(SqlDriver*)> listener) {
+            mTransactionEndListenerMap[key] = std::move(listener);
+        }
+
+        /// Calls the listeners registered by onTransactionEnd() and removes them.
+        void finishTransaction() {
+            std::map<const void*, std::function<void(SqlDriver*)>> listenerMap;
+            listenerMap.swap(mTransactionEndListenerMap);
+            for (const auto& listenerPair : listenerMap)
+                listenerPair.second(this);
+        }
+        //@}
+
+        /// Returns the maximum number of placeholders a single statement may contain.
+        virtual int maxPlaceholderCount() const {
+            return 999;
+        }
+
+        /** 
+         * @brief Prepares the connection just opened by SqlConnectionPool for being shared with the other connections of the pool.
+         * ***isReader*** tells whether the connection only reads, or is the single writer of the pool. 
+         * Drivers override it to apply their own settings, e.g. locking and journaling modes; by default, nothing is done.
+         * @throw Exception if the connection couldn't be configured.
+         */
+        virtual void configurePooledConnection(bool /*isReader*/) {
+        }
+
         /// Returns a list(as a vector of strings) containing the existing database tables.
         virtual std::vector<std::string> tableList() = 0;
 
         /// Returns a list(as a vector of strings) containing the columns of the table ***table*** in order.
         virtual std::vector<std::string> columnList(const std::string& table) = 0;
 
+    private:
+
+        void executeIndependently(const std::string& sqlStatement) {
+            std::unique_ptr<SqlStatement> statement(createStatement(sqlStatement));
+            statement->execute();
+        }
+
+        std::map<const void*, std::function<void(SqlDriver*)>> mTransactionEndListenerMap;
     };
 }
 #endif // SALSABIL_SQLDRIVER_HPP
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLENTITYCACHE_HPP
+#define SALSABIL_SQLENTITYCACHE_HPP
+
+#include "Exception.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Salsabil {
+    class SqlDriver;
+
+    /** 
+     * @class SqlEntityCacheBase
+     * @brief SqlEntityCacheBase is the part of SqlEntityCache which doesn't depend on the type of the entities.
+     * 
+     * It keeps track of the entries invalidated within transactions. While a transaction is in progress, other 
+     * connections still read the committed rows, and a thread may cache one of them right after its entry 
+     * has been invalidated. Hence, the entries invalidated within a transaction are invalidated once more when 
+     * the outermost transaction on the driver ends.
+     */
+    class SqlEntityCacheBase {
+    public:
+
+        /// Forgets the entries of the cache invalidated within transactions in progress.
+        virtual ~SqlEntityCacheBase();
+
+        /// Removes the entry cached under ***key*** if there is any.
+        virtual void invalidate(const std::string& key) = 0;
+
+        /** 
+         * @brief Removes the entry cached under ***key***, as written by ***driver***.
+         * If ***driver*** is in a transaction, the entry is removed again when the outermost transaction on it ends.
+         */
+        void invalidate(SqlDriver* driver, const std::string& key);
+
+        /// Removes once more the entries invalidated during the transaction of ***driver***, which has just ended, from all caches.
+        static void finishTransaction(SqlDriver* driver);
+    };
+
+    /** 
+     * @class SqlEntityCache
+     * @brief SqlEntityCache is a thread-safe, second-level cache of the entities of a single type, shared by all the threads.
+     * 
+     * Entities are kept as copies keyed by their primary key, in a number of shards each of which is a 
+     * least-recently-used list guarded by its own mutex, so that lookups of different keys rarely contend. 
+     * Once the estimated memory use of a shard exceeds its share of the memory budget, its least recently used 
+     * entries are evicted. The size of an entry is estimated by sizeof(ClassType) plus the size of its key, unless 
+     * a size estimator is given, e.g. to account for the heap memory held by strings of the entity.
+     * 
+     * The cache is used by SqlRepository once it is set by SqlEntityConfigurer#setEntityCache(): fetch() looks entities 
+     * up in the cache before querying the database, persist() populates the cache, and update() and remove() invalidate 
+     * the entries of the changed entities, again as their enclosing transaction ends, if any. Entities with relations 
+     * are never cached, since cached copies would share their related instances; the repository of such a type ignores 
+     * its cache and logs so once. For example:
+     * {@code 
+     * SqlEntityCache<User> cache(16 * 1024 * 1024);
+     * SqlEntityConfigurer<User>::setEntityCache(&cache);
+     * }
+     */
+    template<typename ClassType>
+    class SqlEntityCache : public SqlEntityCacheBase {
+    public:
+        using SizeEstimator = std::function<std::size_t(const ClassType&)>;
+
+        /** 
+         * @brief Constructs a cache which holds entries of at most ***memoryBudget*** bytes in total, split into ***shardCount*** shards.
+         * @throw Exception if ***shardCount*** is zero.
+         */
+        explicit SqlEntityCache(std::size_t memoryBudget, std::size_t shardCount = 16, SizeEstimator sizeEstimator = SizeEstimator()) :
+        mMemoryBudget(memoryBudget),
+        mShardList(shardCount),
+        mSizeEstimator(sizeEstimator),
+        mHitCount(0),
+        mMissCount(0),
+        mEvictionCount(0) {
+            if (shardCount == 0)
+                throw Exception("an entity cache needs at least one shard");
+            for (auto& shard : mShardList)
+                shard.reset(new Shard);
+        }
+
+        SqlEntityCache(const SqlEntityCache&) = delete;
+
+        SqlEntityCache& operator=(const SqlEntityCache&) = delete;
+
+        /** 
+         * @brief Copies the entity cached under ***key*** into ***instance***.
+         * @retval true if the entity is cached.
+         * @retval false otherwise.
+         */
+        bool get(const std::string& key, ClassType* instance) {
+            Shard& shard = shardOf(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto iter = shard.entryMap.find(key);
+            if (iter == shard.entryMap.end()) {
+                ++mMissCount;
+                return false;
+            }
+
+            shard.entryList.splice(shard.entryList.begin(), shard.entryList, iter->second);
+            *instance = iter->second->instance;
+            ++mHitCount;
+            return true;
+        }
+
+        /** 
+         * @brief Returns the generation of the shard of ***key***, which changes whenever an entry of the shard is invalidated.
+         * A generation taken before reading an entity from the database is passed to put(), so that an entity read before 
+         * being changed by another thread isn't cached after its entry has been invalidated.
+         */
+        std::uint64_t generation(const std::string& key) {
+            Shard& shard = shardOf(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.generation;
+        }
+
+        /// Caches a copy of ***instance*** under ***key***, unless an entry of its shard has been invalidated since ***generation***.
+        void put(const std::string& key, const ClassType& instance, std::uint64_t generation) {
+            Shard& shard = shardOf(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.generation == generation)
+                insert(shard, key, instance);
+        }
+
+        /// Caches a copy of ***instance*** under ***key***.
+        void put(const std::string& key, const ClassType& instance) {
+            Shard& shard = shardOf(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            insert(shard, key, instance);
+        }
+
+        using SqlEntityCacheBase::invalidate;
+
+        virtual void invalidate(const std::string& key) override {
+            Shard& shard = shardOf(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.generation;
+            auto iter = shard.entryMap.find(key);
+            if (iter == shard.entryMap.end())
+                return;
+            shard.memoryUsage -= iter->second->size;
+            shard.entryList.erase(iter->second);
+            shard.entryMap.erase(iter);
+        }
+
+        /// Removes all the entries.
+        void clear() {
+            for (auto& shard : mShardList) {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                ++shard->generation;
+                shard->entryMap.clear();
+                shard->entryList.clear();
+                shard->memoryUsage = 0;
+            }
+        }
+
+        /// Returns the number of cached entries.
+        std::size_t size() const {
+            std::size_t count = 0;
+            for (const auto& shard : mShardList) {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                count += shard->entryMap.size();
+            }
+            return count;
+        }
+
+        /// Returns the estimated memory used by the cached entries in bytes.
+        std::size_t memoryUsage() const {
+            std::size_t usage = 0;
+            for (const auto& shard : mShardList) {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                usage += shard->memoryUsage;
+            }
+            return usage;
+        }
+
+        std::size_t memoryBudget() const {
+            return mMemoryBudget;
+        }
+
+        /// Returns the number of lookups that found their entity.
+        std::uint64_t hitCount() const {
+            return mHitCount;
+        }
+
+        /// Returns the number of lookups that didn't find their entity.
+        std::uint64_t missCount() const {
+            return mMissCount;
+        }
+
+        /// Returns the number of entries evicted to stay within the memory budget.
+        std::uint64_t evictionCount() const {
+            return mEvictionCount;
+        }
+
+    private:
+
+        struct Entry {
+            std::string key;
+            ClassType instance;
+            std::size_t size;
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::list<Entry> entryList;
+            std::unordered_map<std::string, typename std::list<Entry>::iterator> entryMap;
+            std::size_t memoryUsage = 0;
+            std::uint64_t generation = 0;
+        };
+
+        Shard& shardOf(const std::string& key) {
+            return *mShardList[std::hash<std::string>()(key) % mShardList.size()];
+        }
+
+        std::size_t entrySize(const std::string& key, const ClassType& instance) const {
+            // the key is held by both the list and the map.
+            const std::size_t overhead = sizeof (Entry) + 2 * key.size() + sizeof (typename std::list<Entry>::iterator);
+            return overhead + (mSizeEstimator ? mSizeEstimator(instance) : sizeof (ClassType));
+        }
+
+        void insert(Shard& shard, const std::string& key, const ClassType& instance) {
+            auto iter = shard.entryMap.find(key);
+            if (iter != shard.entryMap.end()) {
+                shard.memoryUsage -= iter->second->size;
+                shard.entryList.erase(iter->second);
+                shard.entryMap.erase(iter);
+            }
+
+            const std::size_t size = entrySize(key, instance);
+            const std::size_t shardBudget = mMemoryBudget / mShardList.size();
+            if (size > shardBudget)
+                return;
+
+            while (shard.memoryUsage + size > shardBudget) {
+                const Entry& leastRecentlyUsed = shard.entryList.back();
+                shard.memoryUsage -= leastRecentlyUsed.size;
+                shard.entryMap.erase(leastRecentlyUsed.key);
+                shard.entryList.pop_back();
+                ++mEvictionCount;
+            }
+
+            shard.entryList.push_front(Entry{key, instance, size});
+            shard.entryMap[key] = shard.entryList.begin();
+            shard.memoryUsage += size;
+        }
+
+        const std::size_t mMemoryBudget;
+        std::vector<std::unique_ptr<Shard>> mShardList;
+        SizeEstimator mSizeEstimator;
+        std::atomic<std::uint64_t> mHitCount;
+        std::atomic<std::uint64_t> mMissCount;
+        std::atomic<std::uint64_t> mEvictionCount;
+    };
+}
+#endif // SALSABIL_SQLENTITYCACHE_HPP
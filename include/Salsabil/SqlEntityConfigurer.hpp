@@ -23,10 +23,15 @@
 #define SALSABIL_SQLENTITYCONFIGURER_HPP
 
 #include "SqlDriver.hpp"
+#include "SqlConnectionPool.hpp"
+#include "SqlEntityCache.hpp"
+#include "SqlQueryCache.hpp"
 #include "Exception.hpp"
 #include "internal/AccessWrapper.hpp"
 #include "internal/SqlFieldImpl.hpp"
 #include "internal/SqlRelationalFieldImpl.hpp"
+#include "internal/SqlStatementTemplate.hpp"
+#include "internal/SqlGenerator.hpp"
 #include "internal/SqlRelationOneToOnePersistentImpl.hpp"
 #include "internal/SqlRelationOneToOneTransientImpl.hpp"
 #include "internal/SqlRelationOneToManyImpl.hpp"
@@ -37,6 +42,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <initializer_list>
+#include <typeinfo>
 
 
 namespace Salsabil {
@@ -66,12 +73,78 @@ namespace Salsabil {
             return mSqlDriver;
         }
 
+        /** 
+         * @brief Makes the repository draw its connections from ***pool*** instead of the driver set by setDriver().
+         * Passing NULL makes the repository use that driver again.
+         */
+        static void setConnectionPool(SqlConnectionPool* pool) {
+            SALSABIL_LOG_DEBUG("Setting SQL connection pool");
+            mConnectionPool = pool;
+        }
+
+        static SqlConnectionPool* connectionPool() {
+            return mConnectionPool;
+        }
+
+        /** 
+         * @brief Makes the repository look entities up in ***cache*** before querying the database, and keep it up to date as entities are written.
+         * Only entities without relations are cached, since cached copies would otherwise share their related instances. 
+         * The cache isn't owned by the configurer; passing NULL stops caching.
+         */
+        static void setEntityCache(SqlEntityCache<ClassType>* cache) {
+            SALSABIL_LOG_DEBUG("Setting entity cache");
+            mEntityCache = cache;
+        }
+
+        static SqlEntityCache<ClassType>* entityCache() {
+            return mEntityCache;
+        }
+
+        /** 
+         * @brief Makes the repository and the relations of the entity answer repeated queries from ***cache***.
+         * The cache isn't owned by the configurer and may be shared by several entity types; passing NULL stops caching.
+         */
+        static void setQueryCache(SqlQueryCache* cache) {
+            SALSABIL_LOG_DEBUG("Setting query cache");
+            mQueryCache = cache;
+        }
+
+        static SqlQueryCache* queryCache() {
+            return mQueryCache;
+        }
+
+        /** 
+         * @brief Creates a statement for the query ***sqlStatement***, which reads from the tables in ***tableNameList***.
+         * The result is served by the query cache if there is any and ***driver*** is not in a transaction, 
+         * since uncommitted rows must neither be cached nor be hidden by cached ones.
+         */
+        static SqlStatement* createQueryStatement(SqlDriver* driver, const std::string& sqlStatement, const std::vector<std::string>& tableNameList) {
+            if (mQueryCache && !driver->isInTransaction())
+                return mQueryCache->createStatement(driver, sqlStatement, tableNameList);
+            return driver->createStatement(sqlStatement);
+        }
+
+        /// Returns a connection to read entities with, checked out from the connection pool if there is any.
+        static SqlConnectionPool::Connection readConnection() {
+            if (mConnectionPool)
+                return mConnectionPool->acquireReader();
+            return SqlConnectionPool::Connection(mSqlDriver);
+        }
+
+        /// Returns a connection to write entities with, checked out from the connection pool if there is any.
+        static SqlConnectionPool::Connection writeConnection() {
+            if (mConnectionPool)
+                return mConnectionPool->acquireWriter();
+            return SqlConnectionPool::Connection(mSqlDriver);
+        }
+
         static void setTableName(const std::string& tableName) {
             SALSABIL_LOG_DEBUG("Setting SQL table: " + tableName);
 
-            for (auto& currentTableName : mSqlDriver->tableList()) {
+            for (auto& currentTableName : readConnection()->tableList()) {
                 if (currentTableName == tableName) {
                     mTableName = tableName;
+                    buildStatementTemplates();
                     return;
                 }
             }
@@ -88,6 +161,8 @@ namespace Salsabil {
             SALSABIL_LOG_DEBUG("Setting primary field (attribute): " + columnName);
             using FieldType = typename Utility::Traits<AttributeType>::AttributeType;
             mPrimaryFieldList.push_back(new SqlFieldImpl<ClassType, FieldType>(columnName, fieldColumnIndex(columnName), new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute)));
+            mAccessorColumnMap[accessorKey(attribute)] = columnName;
+            buildStatementTemplates();
         }
 
         template<typename GetMethodType, typename SetMethodType>
@@ -95,6 +170,8 @@ namespace Salsabil {
             SALSABIL_LOG_DEBUG("Setting primary field (methods): " + columnName);
             using FieldType = typename Utility::Traits<GetMethodType>::ReturnType;
             mPrimaryFieldList.push_back(new SqlFieldImpl<ClassType, FieldType>(columnName, fieldColumnIndex(columnName), new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter)));
+            mAccessorColumnMap[accessorKey(getter)] = columnName;
+            buildStatementTemplates();
         }
 
         template<typename AttributeType>
@@ -102,6 +179,8 @@ namespace Salsabil {
             SALSABIL_LOG_DEBUG("Setting field (attribute): " + columnName);
             using FieldType = typename Utility::Traits<AttributeType>::AttributeType;
             mFieldList.push_back(new SqlFieldImpl<ClassType, FieldType>(columnName, fieldColumnIndex(columnName), new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute)));
+            mAccessorColumnMap[accessorKey(attribute)] = columnName;
+            buildStatementTemplates();
         }
 
         template<typename GetMethodType, typename SetMethodType>
@@ -109,29 +188,33 @@ namespace Salsabil {
             SALSABIL_LOG_DEBUG("Setting field (methods): " + columnName);
             using FieldType = typename Utility::Traits<GetMethodType>::ReturnType;
             mFieldList.push_back(new SqlFieldImpl<ClassType, FieldType>(columnName, fieldColumnIndex(columnName), new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter)));
+            mAccessorColumnMap[accessorKey(getter)] = columnName;
+            buildStatementTemplates();
         }
 
         template<typename AttributeType>
-        static void setOneToOnePersistentField(const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, AttributeType attribute) {
+        static void setOneToOnePersistentField(const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, AttributeType attribute, FetchType fetchType = FetchType::Select) {
             SALSABIL_LOG_DEBUG("Setting one-to-one persistent relational field (attribute): " + targetTableName);
             using FieldType = typename Utility::Traits<AttributeType>::AttributeType;
             mRelationalFieldList.push_back(new SqlRelationalFieldImpl<ClassType, FieldType>(columnNameMap, new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute)));
-            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::OneToOne, new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute)));
+            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::OneToOne, new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute), fetchType));
+            buildStatementTemplates();
         }
 
         template<typename AttributeType>
-        static void setOneToOnePersistentField(const std::string& targetTableName, const std::string& sourceColumnName, const std::string& targetColumnName, AttributeType attribute) {
+        static void setOneToOnePersistentField(const std::string& targetTableName, const std::string& sourceColumnName, const std::string& targetColumnName, AttributeType attribute, FetchType fetchType = FetchType::Select) {
             setOneToOnePersistentField(targetTableName,{
                 {sourceColumnName, targetColumnName}
-            }, attribute);
+            }, attribute, fetchType);
         }
 
         template<typename GetMethodType, typename SetMethodType>
-        static void setOneToOnePersistentField(const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, GetMethodType getter, SetMethodType setter) {
+        static void setOneToOnePersistentField(const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, GetMethodType getter, SetMethodType setter, FetchType fetchType = FetchType::Select) {
             SALSABIL_LOG_DEBUG("Setting one-to-one persistent relational field (methods): " + targetTableName);
             using FieldType = typename Utility::Traits<GetMethodType>::ReturnType;
             mRelationalFieldList.push_back(new SqlRelationalFieldImpl<ClassType, FieldType>(columnNameMap, new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter)));
-            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::OneToOne, new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter)));
+            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::OneToOne, new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter), fetchType));
+            buildStatementTemplates();
         }
 
         template<typename GetMethodType, typename SetMethodType>
@@ -198,34 +281,36 @@ namespace Salsabil {
         }
 
         template<typename AttributeType>
-        static void setManyToOneField(AttributeType attribute, const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap) {
+        static void setManyToOneField(AttributeType attribute, const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, FetchType fetchType = FetchType::Select) {
             SALSABIL_LOG_DEBUG("Setting many-to-one relational field (attribute): " + targetTableName);
             using FieldType = typename Utility::Traits<AttributeType>::AttributeType;
             mRelationalFieldList.push_back(new SqlRelationalFieldImpl<ClassType, FieldType>(columnNameMap, new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute)));
-            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::ManyToOne, new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute)));
+            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::ManyToOne, new AccessWrapperAttributeImpl<ClassType, FieldType, AttributeType>(attribute), fetchType));
+            buildStatementTemplates();
         }
 
         template<typename AttributeType>
-        static void setManyToOneField(AttributeType attribute, const std::string& targetTableName, const std::string& sourceColumnName, const std::string& targetColumnName) {
+        static void setManyToOneField(AttributeType attribute, const std::string& targetTableName, const std::string& sourceColumnName, const std::string& targetColumnName, FetchType fetchType = FetchType::Select) {
             setManyToOneField(attribute, targetTableName,{
                 {sourceColumnName, targetColumnName}
-            });
+            }, fetchType);
         }
 
         template<typename GetMethodType, typename SetMethodType>
-        static void setManyToOneField(GetMethodType getter, SetMethodType setter, const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap) {
+        static void setManyToOneField(GetMethodType getter, SetMethodType setter, const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, FetchType fetchType = FetchType::Select) {
             SALSABIL_LOG_DEBUG("Setting many-to-one relational field (methods): " + targetTableName);
             using FieldType = typename Utility::Traits<GetMethodType>::ReturnType;
 
             mRelationalFieldList.push_back(new SqlRelationalFieldImpl<ClassType, FieldType>(columnNameMap, new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter)));
-            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::ManyToOne, new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter)));
+            mTransientFieldList.push_back(new SqlRelationOneToOnePersistentImpl<ClassType, FieldType>(targetTableName, columnNameMap, RelationType::ManyToOne, new AccessWrapperMethodImpl<ClassType, FieldType, GetMethodType, SetMethodType>(getter, setter), fetchType));
+            buildStatementTemplates();
         }
 
         template<typename GetMethodType, typename SetMethodType>
-        static void setManyToOneField(GetMethodType getter, SetMethodType setter, const std::string& targetTableName, const std::string& sourceColumnName, const std::string& targetColumnName) {
+        static void setManyToOneField(GetMethodType getter, SetMethodType setter, const std::string& targetTableName, const std::string& sourceColumnName, const std::string& targetColumnName, FetchType fetchType = FetchType::Select) {
             setManyToOneField(getter, setter, targetTableName,{
                 {sourceColumnName, targetColumnName}
-            });
+            }, fetchType);
         }
 
         template<typename AttributeType>
@@ -248,12 +333,55 @@ namespace Salsabil {
                 nameList.push_back(field->name());
             for (const auto& field : mFieldList)
                 nameList.push_back(field->name());
-            for (const auto& field : mRelationalFieldList)
-                nameList.push_back(field->name());
+            for (const auto& field : mRelationalFieldList) {
+                auto relationalNameList = field->columnNameList();
+                nameList.insert(nameList.end(), relationalNameList.begin(), relationalNameList.end());
+            }
 
             return nameList;
         }
 
+        /** @brief Returns the statement template selecting a single row by its primary key. */
+        static const SqlStatementTemplate<ClassType>& fetchByIdStatement() {
+            return mFetchByIdStatement;
+        }
+
+        /** @brief Returns the statement template inserting a row with all mapped columns. */
+        static const SqlStatementTemplate<ClassType>& insertStatement() {
+            return mInsertStatement;
+        }
+
+        /** @brief Returns the statement template inserting a row, or updating its non-primary columns if its primary key is taken; empty if no primary field is configured. */
+        static const SqlStatementTemplate<ClassType>& upsertStatement() {
+            return mUpsertStatement;
+        }
+
+        /** @brief Returns the statement template updating the non-primary columns of a row; empty if there is nothing to update. */
+        static const SqlStatementTemplate<ClassType>& updateStatement() {
+            return mUpdateStatement;
+        }
+
+        /** @brief Returns the statement template deleting a single row by its primary key. */
+        static const SqlStatementTemplate<ClassType>& removeStatement() {
+            return mRemoveStatement;
+        }
+
+        /** @brief Returns a key identifying ***instance*** in memory, made of the SQL literals of its primary key values. */
+        static std::string primaryKey(const ClassType* instance) {
+            std::vector<std::string> valueList;
+            for (const auto& field : mPrimaryFieldList)
+                valueList.push_back(field->fetchFromInstance(instance).toString());
+            return Utility::join(valueList.begin(), valueList.end(), ", ");
+        }
+
+        /** @brief Returns the key identifying the instance whose primary key values are ***idList***. */
+        static std::string primaryKey(std::initializer_list<SqlValue> idList) {
+            std::vector<std::string> valueList;
+            for (const auto& id : idList)
+                valueList.push_back(id.toString());
+            return Utility::join(valueList.begin(), valueList.end(), ", ");
+        }
+
         static const std::vector< SqlField<ClassType>* >& primaryFieldList() {
             return mPrimaryFieldList;
         }
@@ -262,6 +390,18 @@ namespace Salsabil {
             return mFieldList;
         }
 
+        /** 
+         * @brief Returns the column of the field configured with ***accessor***, which is either its attribute pointer or its getter.
+         * @throw Exception if no field is configured with ***accessor***.
+         */
+        template<typename AccessorType>
+        static std::string columnName(AccessorType accessor) {
+            auto iter = mAccessorColumnMap.find(accessorKey(accessor));
+            if (iter == mAccessorColumnMap.end())
+                throw Exception("no field of the table " + mTableName + " is configured with the given accessor");
+            return iter->second;
+        }
+
         static const std::vector< SqlRelationalField<ClassType>* >& relationalPersistentFieldList() {
             return mRelationalFieldList;
         }
@@ -285,10 +425,12 @@ namespace Salsabil {
 
                 delete ptr; });
             mTransientFieldList.clear();
+            mAccessorColumnMap.clear();
+            buildStatementTemplates();
         }
 
         static int fieldColumnIndex(const std::string& fieldName) {
-            auto columns = mSqlDriver->columnList(mTableName);
+            auto columns = readConnection()->columnList(mTableName);
             decltype(columns)::iterator iter = std::find(columns.begin(), columns.end(), fieldName);
             if (iter == columns.end())
                 throw Exception("the field " + fieldName + " does not exist in the table " + mTableName);
@@ -298,20 +440,101 @@ namespace Salsabil {
 
     private:
 
+        // identifies an accessor by its type and value, since member pointers of different types can't be compared.
+        template<typename AccessorType>
+        static std::string accessorKey(AccessorType accessor) {
+            std::string key(typeid (AccessorType).name());
+            key.append(reinterpret_cast<const char*> (&accessor), sizeof (accessor));
+            return key;
+        }
+
+        static std::vector<std::string> fieldNameList(const std::vector< SqlField<ClassType>* >& fieldList) {
+            std::vector<std::string> nameList;
+            for (const auto& field : fieldList)
+                nameList.push_back(field->name());
+            return nameList;
+        }
+
+        /* 
+         * Rebuilds the CRUD statements and their bind order out of the current configuration, 
+         * so that the repository only has to bind values and step them. 
+         */
+        static void buildStatementTemplates() {
+            mFetchByIdStatement = SqlStatementTemplate<ClassType>();
+            mInsertStatement = SqlStatementTemplate<ClassType>();
+            mUpsertStatement = SqlStatementTemplate<ClassType>();
+            mUpdateStatement = SqlStatementTemplate<ClassType>();
+            mRemoveStatement = SqlStatementTemplate<ClassType>();
+
+            if (mTableName.empty())
+                return;
+
+            const std::vector<std::string> primaryColumnList = fieldNameList(mPrimaryFieldList);
+            const std::vector<std::string> columnList = columnNameList();
+
+            if (!columnList.empty()) {
+                mInsertStatement = SqlStatementTemplate<ClassType>(SqlGenerator::preparedInsert(mTableName, columnList));
+                mInsertStatement.addParameters(mPrimaryFieldList);
+                mInsertStatement.addParameters(mFieldList);
+                mInsertStatement.addParameters(mRelationalFieldList);
+            }
+
+            if (primaryColumnList.empty())
+                return;
+
+            mFetchByIdStatement = SqlStatementTemplate<ClassType>(SqlGenerator::preparedFetchById(mTableName, primaryColumnList));
+            mFetchByIdStatement.addParameters(mPrimaryFieldList);
+
+            mRemoveStatement = SqlStatementTemplate<ClassType>(SqlGenerator::preparedRemove(mTableName, primaryColumnList));
+            mRemoveStatement.addParameters(mPrimaryFieldList);
+
+            // the upsert binds its parameters in the order of the insert.
+            mUpsertStatement = SqlStatementTemplate<ClassType>(SqlGenerator::preparedUpsert(mTableName, columnList, primaryColumnList));
+            mUpsertStatement.addParameters(mPrimaryFieldList);
+            mUpsertStatement.addParameters(mFieldList);
+            mUpsertStatement.addParameters(mRelationalFieldList);
+
+            if (columnList.size() > primaryColumnList.size()) {
+                const std::vector<std::string> updateColumnList(columnList.begin() + primaryColumnList.size(), columnList.end());
+                mUpdateStatement = SqlStatementTemplate<ClassType>(SqlGenerator::preparedUpdate(mTableName, updateColumnList, primaryColumnList));
+                mUpdateStatement.addParameters(mFieldList);
+                mUpdateStatement.addParameters(mRelationalFieldList);
+                mUpdateStatement.addParameters(mPrimaryFieldList);
+            }
+        }
+
         static SqlDriver* mSqlDriver;
+        static SqlConnectionPool* mConnectionPool;
+        static SqlEntityCache<ClassType>* mEntityCache;
+        static SqlQueryCache* mQueryCache;
         static std::string mTableName;
         static std::vector< SqlField<ClassType>* > mPrimaryFieldList;
         static std::vector< SqlField<ClassType>* > mFieldList;
         static std::vector< SqlRelationalField<ClassType>* > mRelationalFieldList;
         static std::vector< SqlRelation<ClassType>* > mTransientFieldList;
+        static std::map<std::string, std::string> mAccessorColumnMap;
+        static SqlStatementTemplate<ClassType> mFetchByIdStatement;
+        static SqlStatementTemplate<ClassType> mInsertStatement;
+        static SqlStatementTemplate<ClassType> mUpsertStatement;
+        static SqlStatementTemplate<ClassType> mUpdateStatement;
+        static SqlStatementTemplate<ClassType> mRemoveStatement;
     };
 
     template<typename C> SqlDriver* SqlEntityConfigurer<C>::mSqlDriver = nullptr;
+    template<typename C> SqlConnectionPool* SqlEntityConfigurer<C>::mConnectionPool = nullptr;
+    template<typename C> SqlEntityCache<C>* SqlEntityConfigurer<C>::mEntityCache = nullptr;
+    template<typename C> SqlQueryCache* SqlEntityConfigurer<C>::mQueryCache = nullptr;
     template<typename C> std::string SqlEntityConfigurer<C>::mTableName;
     template<typename C> std::vector< SqlField<C>* > SqlEntityConfigurer<C>::mPrimaryFieldList;
     template<typename C> std::vector< SqlField<C>* > SqlEntityConfigurer<C>::mFieldList;
     template<typename C> std::vector< SqlRelationalField<C>* > SqlEntityConfigurer<C>::mRelationalFieldList;
     template<typename C> std::vector< SqlRelation<C>* > SqlEntityConfigurer<C>::mTransientFieldList;
+    template<typename C> std::map<std::string, std::string> SqlEntityConfigurer<C>::mAccessorColumnMap;
+    template<typename C> SqlStatementTemplate<C> SqlEntityConfigurer<C>::mFetchByIdStatement;
+    template<typename C> SqlStatementTemplate<C> SqlEntityConfigurer<C>::mInsertStatement;
+    template<typename C> SqlStatementTemplate<C> SqlEntityConfigurer<C>::mUpsertStatement;
+    template<typename C> SqlStatementTemplate<C> SqlEntityConfigurer<C>::mUpdateStatement;
+    template<typename C> SqlStatementTemplate<C> SqlEntityConfigurer<C>::mRemoveStatement;
 }
 
 #endif // SALSABIL_SQLENTITYCONFIGURER_HPP 
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLQUERY_HPP
+#define SALSABIL_SQLQUERY_HPP
+
+#include "SqlStatement.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "internal/SqlGenerator.hpp"
+#include "internal/SqlValue.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Salsabil {
+
+    /// The direction in which SqlQuery#orderBy() sorts the rows.
+    enum class SortOrder {
+        Ascending, Descending
+    };
+
+    /** 
+     * @class SqlQuery
+     * @brief SqlQuery is a builder of a filtered, sorted and limited query of the entities of a class.
+     * 
+     * Fields are referred to by the attribute pointers or getters they are configured with. Conditions are 
+     * combined by AND, and their values are bound as parameters, so the rows are filtered by the database, 
+     * which can use its indexes. A query may also be restricted to a few fields of the entities by select(), 
+     * so that only their columns are read. Queries are run by SqlRepository#fetchAll() and SqlRepository#stream(). 
+     * For example:
+     * {@code 
+     * std::vector<User*> userList = SqlRepository<User>::fetchAll(SqlQuery<User>()
+     *      .greaterThan(&User::age, 30)
+     *      .like(&User::getName, "A%")
+     *      .orderBy(&User::age, SortOrder::Descending)
+     *      .limit(10));
+     * }
+     */
+    template<typename ClassType>
+    class SqlQuery {
+    public:
+
+        SqlQuery() : mIsFetchingRelations(false), mLimit(-1), mOffset(0) {
+        }
+
+        /** 
+         * @brief Restricts the fields hydrated by the query to ***fields***, along with the primary fields, which are always hydrated.
+         * Only the columns of these fields are selected, and relations are skipped unless withRelations() is called. 
+         * The other fields of the fetched entities are left as constructed.
+         * @throw Exception if no field is configured with any of ***fields***.
+         */
+        template<typename... AccessorTypes>
+        SqlQuery& select(AccessorTypes... fields) {
+            project(fields...);
+            return *this;
+        }
+
+        /// Makes a query restricted by select(), or any query a stream is opened with, hydrate the relations too, along with the foreign keys they are read by.
+        SqlQuery& withRelations() {
+            mIsFetchingRelations = true;
+            return *this;
+        }
+
+        /// Returns whether withRelations() is called.
+        bool isRequestingRelations() const {
+            return mIsFetchingRelations;
+        }
+
+        /// Returns whether the hydrated fields are restricted by select().
+        bool isProjection() const {
+            return !mProjectionList.empty();
+        }
+
+        /// Returns the columns of the fields selected by select().
+        const std::vector<std::string>& projectionList() const {
+            return mProjectionList;
+        }
+
+        /// Returns whether the relations are hydrated, which they are unless the query is a projection without withRelations().
+        bool isFetchingRelations() const {
+            return !isProjection() || mIsFetchingRelations;
+        }
+
+        /** 
+         * @name Condition Functions
+         * @brief These functions restrict the query to the rows whose column of ***field*** compares to ***value*** as named.
+         * @throw Exception if no field is configured with ***field***.
+         */
+        //@{
+        template<typename AccessorType>
+        SqlQuery& equal(AccessorType field, const SqlValue& value) {
+            return compare(field, " = ", value);
+        }
+
+        template<typename AccessorType>
+        SqlQuery& notEqual(AccessorType field, const SqlValue& value) {
+            return compare(field, " <> ", value);
+        }
+
+        template<typename AccessorType>
+        SqlQuery& lessThan(AccessorType field, const SqlValue& value) {
+            return compare(field, " < ", value);
+        }
+
+        template<typename AccessorType>
+        SqlQuery& lessOrEqual(AccessorType field, const SqlValue& value) {
+            return compare(field, " <= ", value);
+        }
+
+        template<typename AccessorType>
+        SqlQuery& greaterThan(AccessorType field, const SqlValue& value) {
+            return compare(field, " > ", value);
+        }
+
+        template<typename AccessorType>
+        SqlQuery& greaterOrEqual(AccessorType field, const SqlValue& value) {
+            return compare(field, " >= ", value);
+        }
+
+        /// Restricts the query to the rows whose column of ***field*** matches the LIKE ***pattern***.
+        template<typename AccessorType>
+        SqlQuery& like(AccessorType field, const std::string& pattern) {
+            return compare(field, " LIKE ", pattern);
+        }
+
+        /// Restricts the query to the rows whose column of ***field*** equals any of ***valueList***; an empty list matches no row.
+        template<typename AccessorType>
+        SqlQuery& in(AccessorType field, const std::vector<SqlValue>& valueList) {
+            if (valueList.empty()) {
+                mConditionList.push_back("0");
+                return *this;
+            }
+            mConditionList.push_back(SqlGenerator::preparedIn({column(field)}, valueList.size(), mParameterList.size() + 1));
+            mParameterList.insert(mParameterList.end(), valueList.begin(), valueList.end());
+            return *this;
+        }
+
+        /// Restricts the query to the rows whose column of ***field*** is NULL.
+        template<typename AccessorType>
+        SqlQuery& isNull(AccessorType field) {
+            mConditionList.push_back(column(field) + " IS NULL");
+            return *this;
+        }
+
+        /// Restricts the query to the rows whose column of ***field*** is not NULL.
+        template<typename AccessorType>
+        SqlQuery& isNotNull(AccessorType field) {
+            mConditionList.push_back(column(field) + " IS NOT NULL");
+            return *this;
+        }
+        //@}
+
+        /** 
+         * @brief Sorts the rows by the column of ***field*** in ***order***; rows equal in the columns given before are sorted by the ones given after.
+         * @throw Exception if no field is configured with ***field***.
+         */
+        template<typename AccessorType>
+        SqlQuery& orderBy(AccessorType field, SortOrder order = SortOrder::Ascending) {
+            mOrderList.push_back(column(field) + (order == SortOrder::Ascending ? " ASC" : " DESC"));
+            return *this;
+        }
+
+        /// Limits the query to at most ***count*** rows.
+        SqlQuery& limit(std::size_t count) {
+            mLimit = static_cast<long long> (count);
+            return *this;
+        }
+
+        /// Skips the first ***count*** rows of the query.
+        SqlQuery& offset(std::size_t count) {
+            mOffset = static_cast<long long> (count);
+            return *this;
+        }
+
+        /// Returns whether the query is limited or offset.
+        bool isLimited() const {
+            return mLimit >= 0 || mOffset > 0;
+        }
+
+        /// Returns whether the query sorts its rows.
+        bool isOrdered() const {
+            return !mOrderList.empty();
+        }
+
+        /// Returns the statement querying the rows of ***selection*** restricted, sorted and limited as built, and grouped by ***groupList*** if it isn't empty.
+        std::string text(const std::string& selection, const std::vector<std::string>& groupList = std::vector<std::string>()) const {
+            return SqlGenerator::preparedSelect(selection, mConditionList, mOrderList, isLimited() ? mParameterList.size() + 1 : 0, groupList);
+        }
+
+        /// Binds the values of the conditions, the limit and the offset to ***statement*** prepared out of text().
+        void bind(SqlStatement* statement) const {
+            int position = 1;
+            for (const auto& value : mParameterList)
+                value.bindTo(statement, position++);
+            if (isLimited()) {
+                statement->bindInt64(position++, mLimit);
+                statement->bindInt64(position, mOffset);
+            }
+        }
+
+    private:
+
+        void project() {
+        }
+
+        template<typename AccessorType, typename... AccessorTypes>
+        void project(AccessorType field, AccessorTypes... fields) {
+            mProjectionList.push_back(SqlEntityConfigurer<ClassType>::columnName(field));
+            project(fields...);
+        }
+
+        template<typename AccessorType>
+        SqlQuery& compare(AccessorType field, const std::string& comparison, const SqlValue& value) {
+            mConditionList.push_back(column(field) + comparison + SqlGenerator::placeholder(mParameterList.size() + 1));
+            mParameterList.push_back(value);
+            return *this;
+        }
+
+        // the column is qualified by the table, since the query may join the tables of relations fetched by a join.
+        template<typename AccessorType>
+        static std::string column(AccessorType field) {
+            return SqlEntityConfigurer<ClassType>::tableName() + "." + SqlEntityConfigurer<ClassType>::columnName(field);
+        }
+
+        std::vector<std::string> mConditionList;
+        std::vector<std::string> mOrderList;
+        std::vector<SqlValue> mParameterList;
+        std::vector<std::string> mProjectionList;
+        bool mIsFetchingRelations;
+        long long mLimit;
+        long long mOffset;
+    };
+}
+
+#endif // SALSABIL_SQLQUERY_HPP
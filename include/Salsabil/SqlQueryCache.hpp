@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLQUERYCACHE_HPP
+#define SALSABIL_SQLQUERYCACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Salsabil {
+    class SqlDriver;
+    class SqlStatement;
+
+    /** 
+     * @class SqlQueryCache
+     * @brief SqlQueryCache keeps the result sets of queries, so that repeated queries are answered without running them again.
+     * 
+     * Results are keyed by the normalized text of the query along with the values bound to it, and are evicted 
+     * in least recently used order once their total size exceeds the memory budget. Each result remembers the 
+     * version of every table it has been read from. Writing to a table bumps its version through invalidateTable(), 
+     * so a result read before the write is never served afterwards. The repositories bump the versions of the tables 
+     * they write to by themselves; tables changed by statements executed directly on a driver must be invalidated 
+     * explicitly. A version bumped inside a transaction is bumped once more when the outermost transaction ends, 
+     * so readers on other connections don't cache the rows they saw before the commit.
+     * 
+     * The cache is consulted by the queries of the repositories and relations of the entity types it is registered 
+     * with, except inside transactions. For example:
+     * {@code 
+     * SqlQueryCache cache(16 * 1024 * 1024);
+     * SqlEntityConfigurer<User>::setQueryCache(&cache);
+     * SqlEntityConfigurer<Phone>::setQueryCache(&cache);
+     * }
+     * The cache is safe to be shared by several threads and must outlive the statements it has created.
+     */
+    class SqlQueryCache {
+    public:
+
+        /// Constructs a cache which holds result sets of at most ***memoryBudget*** bytes in total.
+        explicit SqlQueryCache(std::size_t memoryBudget);
+
+        ~SqlQueryCache();
+
+        SqlQueryCache(const SqlQueryCache&) = delete;
+
+        SqlQueryCache& operator=(const SqlQueryCache&) = delete;
+
+        /** 
+         * @brief Creates a statement for ***sqlStatement*** on ***driver***, which reads from the tables in ***tableNameList***.
+         * Executing the statement serves the cached result of the same query with the same bindings if there is any, 
+         * otherwise the query is run on ***driver*** and its result is cached once all of its rows are fetched. 
+         * The returned statement is owned by the caller.
+         */
+        SqlStatement* createStatement(SqlDriver* driver, const std::string& sqlStatement, const std::vector<std::string>& tableNameList);
+
+        /// Removes all the cached results.
+        void clear();
+
+        /// Returns the number of cached results.
+        std::size_t size() const;
+
+        /// Returns the estimated memory held by the cached results in bytes.
+        std::size_t memoryUsage() const;
+
+        /// Returns the maximum memory to be held by the cached results in bytes.
+        std::size_t memoryBudget() const;
+
+        /// Returns the number of executions served from the cache.
+        std::uint64_t hitCount() const;
+
+        /// Returns the number of executions which had to run their query.
+        std::uint64_t missCount() const;
+
+        /** 
+         * @brief Bumps the version of ***tableName***, so that the results read from it so far are not served anymore.
+         * If ***driver*** is in a transaction, the version is bumped again when the outermost transaction on it ends.
+         */
+        static void invalidateTable(SqlDriver* driver, const std::string& tableName);
+
+        /// Returns the current version of ***tableName***.
+        static std::uint64_t tableVersion(const std::string& tableName);
+
+        /// Bumps once more the versions of the tables invalidated during the transaction of ***driver***, which has just ended.
+        static void finishTransaction(SqlDriver* driver);
+
+    private:
+        class CachedStatement;
+
+        struct Value {
+            bool isNull;
+            std::int64_t integer;
+            double real;
+            std::string bytes;
+        };
+
+        struct Result {
+            int columnCount;
+            std::vector<std::vector<Value>> rowList;
+            std::vector<std::pair<std::string, std::uint64_t>> tableVersionList;
+            std::size_t size;
+        };
+
+        struct Entry {
+            std::string key;
+            std::shared_ptr<const Result> result;
+        };
+
+        std::shared_ptr<const Result> find(const std::string& key);
+        void insert(const std::string& key, std::shared_ptr<const Result> result);
+
+        const std::size_t mMemoryBudget;
+
+        mutable std::mutex mMutex;
+        std::list<Entry> mEntryList;
+        std::unordered_map<std::string, std::list<Entry>::iterator> mEntryMap;
+        std::size_t mMemoryUsage;
+
+        std::atomic<std::uint64_t> mHitCount;
+        std::atomic<std::uint64_t> mMissCount;
+    };
+}
+
+#endif // SALSABIL_SQLQUERYCACHE_HPP
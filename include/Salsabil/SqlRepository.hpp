@@ -28,160 +28,1319 @@
 #include "internal/SqlValue.hpp"
 #include "internal/Logging.hpp"
 #include "internal/SqlField.hpp"
+#include "internal/SqlBindingRecorder.hpp"
 #include "SqlEntityConfigurer.hpp"
+#include "SqlQuery.hpp"
+#include "SqlTransaction.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 
 namespace Salsabil {
     template<typename ClassType> class SqlEntityConfigurer;
 
     template<typename ClassType>
     class SqlRepository {
+
+        // the type of the field configured with the accessor, which is either its attribute pointer or its getter.
+        template<typename AccessorType>
+        using FieldType = typename std::decay<typename Utility::Traits<AccessorType>::ReturnType>::type;
+
+        /* 
+         * The selection of a query along with the columns each hydrated field is read from. Partial projections select 
+         * the columns of a few fields only, relations are read by separate queries if they are fetched at all. 
+         */
+        struct Projection {
+            std::string selection;
+            std::vector<std::string> tableNameList;
+            bool isPartial;
+            bool isFetchingRelations;
+            std::vector<std::pair<SqlField<ClassType>*, int>> fieldList;
+            std::vector<std::pair<SqlRelationalField<ClassType>*, int>> relationalFieldList;
+        };
+
     public:
 
+        /** 
+         * @class Stream
+         * @brief Stream is a movable, single-pass range over the result set of a query, which hydrates one entity at a time.
+         * 
+         * Dereferencing an iterator yields the instance owned by the stream, which is overwritten as the 
+         * iterator is incremented. Iterators are invalidated if the stream is moved or destroyed.
+         * 
+         * Unless its query requests them by SqlQuery#withRelations(), relations are not read. The instances 
+         * of the foreign keys injected into the entity, e.g. of a many-to-one pointer, are owned by the stream 
+         * then, and freed as the next row is hydrated. If relations are read, the instances they are read 
+         * into are owned by the caller, which frees them for each row as it does for fetchAll().
+         */
+        class Stream {
+        public:
+
+            class Iterator {
+            public:
+                typedef std::input_iterator_tag iterator_category;
+                typedef ClassType value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef ClassType* pointer;
+                typedef ClassType& reference;
+
+                ClassType& operator*() const {
+                    return mStream->mInstance;
+                }
+
+                ClassType* operator->() const {
+                    return &mStream->mInstance;
+                }
+
+                Iterator& operator++() {
+                    if (!mStream->advance())
+                        mStream = nullptr;
+                    return *this;
+                }
+
+                bool operator==(const Iterator& other) const {
+                    return mStream == other.mStream;
+                }
+
+                bool operator!=(const Iterator& other) const {
+                    return mStream != other.mStream;
+                }
+
+            private:
+                friend class Stream;
+
+                explicit Iterator(Stream* stream) : mStream(stream) {
+                }
+
+                Stream* mStream;
+            };
+
+            Stream(Stream&&) = default;
+
+            // the statement is finalized before the connection it runs on is given back, which another thread may check out right away.
+            Stream& operator=(Stream&& other) {
+                if (this != &other) {
+                    releaseKeys();
+                    mStatement = std::move(other.mStatement);
+                    mProjection = std::move(other.mProjection);
+                    mInstance = std::move(other.mInstance);
+                    mIsStarted = other.mIsStarted;
+                    mHasRow = other.mHasRow;
+                    mConnection = std::move(other.mConnection);
+                }
+                return *this;
+            }
+
+            ~Stream() {
+                releaseKeys();
+            }
+
+            /// Fetches the first row, unless it is already fetched, and returns an iterator to its entity.
+            Iterator begin() {
+                if (!mIsStarted) {
+                    mIsStarted = true;
+                    mHasRow = advance();
+                }
+                return Iterator(mHasRow ? this : nullptr);
+            }
+
+            /// Returns the past-the-end iterator.
+            Iterator end() {
+                return Iterator(nullptr);
+            }
+
+        private:
+            friend class SqlRepository;
+
+            Stream(SqlConnectionPool::Connection&& connection, std::unique_ptr<SqlStatement>&& statement, Projection&& projection) :
+            mConnection(std::move(connection)),
+            mStatement(std::move(statement)),
+            mProjection(std::move(projection)),
+            mIsStarted(false),
+            mHasRow(false) {
+            }
+
+            bool advance() {
+                releaseKeys();
+                mHasRow = mStatement->nextRow();
+                if (mHasRow)
+                    hydrate(mStatement.get(), mConnection.driver(), mProjection, &mInstance);
+                return mHasRow;
+            }
+
+            // frees the foreign key instances injected into the instance by the current row, unless relations are read into them.
+            // A moved-from stream has no statement, the instances are the ones of the stream it is moved into.
+            void releaseKeys() {
+                if (!mStatement || !mHasRow || mProjection.isPartial || mProjection.isFetchingRelations)
+                    return;
+                for (const auto& f : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList())
+                    f->release(&mInstance);
+            }
+
+            // the statement is declared after the connection, so it is finalized before the connection is given back.
+            SqlConnectionPool::Connection mConnection;
+            std::unique_ptr<SqlStatement> mStatement;
+            Projection mProjection;
+            ClassType mInstance;
+            bool mIsStarted;
+            bool mHasRow;
+        };
+
         SqlRepository() {
         }
 
         static ClassType* fetch(std::initializer_list<SqlValue> idList) {
+            std::unique_ptr<ClassType> instance(new ClassType);
+            if (!tryFetch(idList, instance.get()))
+                throw Exception("no row with id(s) was found");
+            return instance.release();
+        }
+
+        static ClassType* fetch(SqlValue id) {
+            return fetch({id});
+        }
+
+        /** 
+         * @brief Returns the entity whose primary key is ***idList***, or a null pointer instead of throwing if there is none.
+         * @throw Exception if no primary field is configured.
+         */
+        static ClassType* tryFetch(std::initializer_list<SqlValue> idList) {
+            std::unique_ptr<ClassType> instance(new ClassType);
+            return tryFetch(idList, instance.get()) ? instance.release() : nullptr;
+        }
+
+        static ClassType* tryFetch(SqlValue id) {
+            return tryFetch({id});
+        }
+
+        /** 
+         * @brief Hydrates ***instance*** from the entity whose primary key is ***idList***, or returns false leaving it untouched if there is none.
+         * A lookup that misses costs no exception, which suits lookups expected to miss often. For example:
+         * {@code 
+         * User user;
+         * if (!SqlRepository<User>::tryFetch({42}, &user)) {
+         *  user.setId(42);
+         *  SqlRepository<User>::persist(&user);
+         * }
+         * }
+         * @throw Exception if no primary field is configured.
+         */
+        static bool tryFetch(std::initializer_list<SqlValue> idList, ClassType* instance) {
             if (SqlEntityConfigurer<ClassType>::primaryFieldList().size() == 0)
                 throw Exception("Could not fetch data, no primary field is configured.");
 
             assert(SqlEntityConfigurer<ClassType>::primaryFieldList().size() == idList.size());
 
-            std::map<std::string, std::string> columnValueMap;
-            std::initializer_list<SqlValue>::const_iterator idIter = idList.begin();
-            for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList()) {
-                columnValueMap.insert({field->name(), idIter->toString()});
-                idIter++;
+            SqlEntityCache<ClassType>* cache = entityCache();
+            std::string key;
+            std::uint64_t generation = 0;
+            if (cache) {
+                key = SqlEntityConfigurer<ClassType>::primaryKey(idList);
+                if (cache->get(key, instance))
+                    return true;
+                generation = cache->generation(key);
             }
 
-            const std::string& sqlStatement = SqlGenerator::fetchById(SqlEntityConfigurer<ClassType>::tableName(), columnValueMap);
+            const std::string& sqlStatement = hasJoinFetchedRelation() ? joinedFetchById() : SqlEntityConfigurer<ClassType>::fetchByIdStatement().text();
 
             SALSABIL_LOG_INFO(sqlStatement);
 
-            SqlDriver* driver = SqlEntityConfigurer<ClassType>::driver();
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+            SqlDriver* driver = connection.driver();
 
-            driver->execute(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(driver->createStatement(sqlStatement));
+            int position = 1;
+            for (const auto& id : idList)
+                id.bindTo(statement.get(), position++);
+            statement->execute();
 
-            if (!driver->nextRow())
-                throw Exception("no row with id(s) was found");
+            if (!statement->nextRow())
+                return false;
 
-            ClassType* instance;
-            ClassType* pInstance = Utility::initializeInstance(&instance);
+            hydrate(statement.get(), driver, entityProjection(), instance);
 
-            for (auto f : SqlEntityConfigurer<ClassType>::primaryFieldList())
-                f->readFromDriver(pInstance, f->column());
-            for (const auto& f : SqlEntityConfigurer<ClassType>::fieldList())
-                f->readFromDriver(pInstance, f->column());
-            for (auto f : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList())
-                f->injectInto(pInstance);
-            for (auto r : SqlEntityConfigurer<ClassType>::transientFieldList())
-                r->readFromDriver(driver, pInstance);
-            return instance;
+            // rows read within a transaction may not be committed yet, so they aren't cached.
+            if (cache && !driver->isInTransaction())
+                cache->put(key, *instance, generation);
+            return true;
         }
 
-        static ClassType* fetch(SqlValue id) {
-            return fetch({id});
+        static std::vector<ClassType*> fetchAll() {
+            return fetchAll(SqlQuery<ClassType>());
         }
 
-        static std::vector<ClassType*> fetchAll() {
+        /** 
+         * @brief Returns the entities matching ***query***, in its order, hydrating only the fields it selects if it is a projection.
+         * @throw Exception if no primary field is configured.
+         */
+        static std::vector<ClassType*> fetchAll(const SqlQuery<ClassType>& query) {
             if (SqlEntityConfigurer<ClassType>::primaryFieldList().size() == 0)
                 throw Exception("Could not fetch data, no primary field is configured.");
 
-            SqlDriver* driver = SqlEntityConfigurer<ClassType>::driver();
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+            SqlDriver* driver = connection.driver();
 
-            const std::string& sqlStatement = SqlGenerator::fetchAll(SqlEntityConfigurer<ClassType>::tableName());
+            const Projection& projection = project(query);
+            const std::string& sqlStatement = query.text(projection.selection);
             SALSABIL_LOG_INFO(sqlStatement);
 
-            driver->execute(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, projection.tableNameList));
+            query.bind(statement.get());
+            statement->execute();
 
-            std::vector<ClassType*> instanceList;
+            std::vector<ClassType*> instanceList = readRows(statement.get(), driver, projection, std::numeric_limits<std::size_t>::max());
+            readRelations(driver, projection, instanceList);
+            return instanceList;
+        }
 
-            while (driver->nextRow()) {
-                ClassType* instance;
-                ClassType* pInstance = Utility::initializeInstance(&instance);
+        /** 
+         * @brief Returns all the entities, representing the row of each primary key for which ***heldInstance*** returns an instance by that instance.
+         * Only the primary key columns of such rows are read, so nothing is hydrated for them. The other rows are hydrated 
+         * along with their relations as by fetchAll(). SqlSession fetches the rows of the instances it doesn't hold yet by it.
+         * @throw Exception if no primary field is configured.
+         */
+        static std::vector<ClassType*> fetchAll(const std::function<ClassType*(const std::string&)>& heldInstance) {
+            if (SqlEntityConfigurer<ClassType>::primaryFieldList().size() == 0)
+                throw Exception("Could not fetch data, no primary field is configured.");
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+            SqlDriver* driver = connection.driver();
 
+            const Projection& projection = project(SqlQuery<ClassType>());
+            SALSABIL_LOG_INFO(projection.selection);
+
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, projection.selection, projection.tableNameList));
+            statement->execute();
+
+            std::vector<ClassType*> instanceList;
+            std::vector<ClassType*> hydratedInstanceList;
+            ClassType keyInstance;
+            while (statement->nextRow()) {
                 for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList())
-                    f->readFromDriver(pInstance, f->column());
-                for (const auto& f : SqlEntityConfigurer<ClassType>::fieldList())
-                    f->readFromDriver(pInstance, f->column());
-                for (const auto& f : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList())
-                    f->injectInto(pInstance);
-                for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList())
-                    r->readFromDriver(driver, pInstance);
+                    f->readFromStatement(statement.get(), &keyInstance, f->column());
 
+                ClassType* instance = heldInstance(SqlEntityConfigurer<ClassType>::primaryKey(&keyInstance));
+                if (!instance) {
+                    instance = new ClassType;
+                    hydrateColumns(statement.get(), driver, projection, instance);
+                    hydratedInstanceList.push_back(instance);
+                }
                 instanceList.push_back(instance);
             }
-
+            readRelations(driver, projection, hydratedInstanceList);
             return instanceList;
         }
 
-        static void persist(const ClassType * instance) {
-            SqlDriver* driver = SqlEntityConfigurer<ClassType>::driver();
+        /** 
+         * @struct Page
+         * @brief Page holds the entities fetched by fetchPage() along with the token to fetch the page following them.
+         */
+        struct Page {
+            /// The entities of the page in the order of their primary keys, which are owned by the caller.
+            std::vector<ClassType*> entityList;
 
-            for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
-                relation->writeToDriver(driver, instance);
+            /// The token to pass to fetchPage() for the next page, which is empty if this is the last page.
+            std::string continuationToken;
+
+            bool isLast() const {
+                return continuationToken.empty();
+            }
+        };
+
+        /** 
+         * @brief Returns at most ***pageSize*** entities following the page whose token is ***continuationToken***, or the first page if the token is empty.
+         * Pages are sought by the primary key, comparing composite keys as row values, instead of skipping the rows of the 
+         * pages before them, so a deep page costs as much as the first one. Rows inserted or removed meanwhile don't make 
+         * the following pages repeat or miss rows. For example:
+         * {@code 
+         * SqlRepository<User>::Page page = SqlRepository<User>::fetchPage(100);
+         * while (!page.isLast())
+         *  page = SqlRepository<User>::fetchPage(100, page.continuationToken);
+         * }
+         * @throw Exception if no primary field is configured, ***pageSize*** is zero or ***continuationToken*** is malformed.
+         */
+        static Page fetchPage(std::size_t pageSize, const std::string& continuationToken = std::string()) {
+            const auto& primaryFieldList = SqlEntityConfigurer<ClassType>::primaryFieldList();
+            if (primaryFieldList.size() == 0)
+                throw Exception("Could not fetch data, no primary field is configured.");
+            if (pageSize == 0)
+                throw Exception("Could not fetch data, the page size is zero.");
 
-            std::map<std::string, std::string> columnValueMap;
-            for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList())
-                columnValueMap.insert({field->name(), field->fetchFromInstance(instance).toString()});
-            for (auto field : SqlEntityConfigurer<ClassType>::fieldList())
-                columnValueMap.insert({field->name(), field->fetchFromInstance(instance).toString()});
+            std::vector<std::string> keyColumnList;
+            for (const auto& f : primaryFieldList)
+                keyColumnList.push_back(SqlEntityConfigurer<ClassType>::tableName() + "." + f->name());
 
-            for (auto field : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList()) {
-                auto m = field->parseFrom(instance);
-                columnValueMap.insert(m.begin(), m.end());
+            std::vector<std::string> conditionList;
+            std::vector<SqlValue> keyValueList;
+            if (!continuationToken.empty()) {
+                keyValueList = decodeKey(continuationToken);
+                conditionList.push_back(SqlGenerator::preparedSeek(keyColumnList));
             }
-            const std::string& sqlStatement = SqlGenerator::insert(SqlEntityConfigurer<ClassType>::tableName(), columnValueMap);
 
+            std::vector<std::string> orderList;
+            for (const auto& column : keyColumnList)
+                orderList.push_back(column + " ASC");
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+            SqlDriver* driver = connection.driver();
+
+            const Projection& projection = project(SqlQuery<ClassType>());
+            const std::string& sqlStatement = SqlGenerator::preparedSelect(projection.selection, conditionList, orderList, keyValueList.size() + 1);
             SALSABIL_LOG_INFO(sqlStatement);
 
-            driver->execute(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, projection.tableNameList));
+            int position = 1;
+            for (const auto& value : keyValueList)
+                value.bindTo(statement.get(), position++);
+            // a row beyond the page tells whether there is a next page. Page sizes beyond the range of the limit are clamped, rather than wrapped around.
+            statement->bindInt64(position++, static_cast<std::int64_t> (std::min<std::size_t>(pageSize, std::numeric_limits<std::int64_t>::max() - 1)) + 1);
+            statement->bindInt64(position, 0);
+            statement->execute();
+
+            Page page;
+            page.entityList = readRows(statement.get(), driver, projection, pageSize);
+            if (statement->nextRow())
+                page.continuationToken = encodeKey(page.entityList.back());
+            readRelations(driver, projection, page.entityList);
+            return page;
+        }
+
+        /** 
+         * @brief Returns the number of entities matching ***query***, or of all the entities if it has no conditions.
+         * Like the other aggregates, the value is computed by the database and read from a single column, so no 
+         * entity is hydrated whatever the number of rows. The order, limit and offset of ***query*** pick the rows 
+         * aggregated, e.g. counting a query limited to 10 rows returns at most 10.
+         */
+        static std::size_t count(const SqlQuery<ClassType>& query = SqlQuery<ClassType>()) {
+            std::size_t result = 0;
+            aggregate("COUNT", "*", std::string(), query, [&result](const SqlStatement * statement) {
+                result = static_cast<std::size_t> (statement->getInt64(0));
+            });
+            return result;
+        }
+
+        /** 
+         * @brief Returns whether an entity whose primary key is ***idList*** exists, without fetching it.
+         * @throw Exception if no primary field is configured.
+         */
+        static bool exists(std::initializer_list<SqlValue> idList) {
+            const auto& primaryFieldList = SqlEntityConfigurer<ClassType>::primaryFieldList();
+            if (primaryFieldList.size() == 0)
+                throw Exception("Could not fetch data, no primary field is configured.");
+
+            assert(primaryFieldList.size() == idList.size());
+
+            std::vector<std::string> columnList;
+            for (const auto& f : primaryFieldList)
+                columnList.push_back(f->name());
+
+            const std::string& sqlStatement = SqlGenerator::preparedExists(SqlEntityConfigurer<ClassType>::tableName(), columnList);
+            SALSABIL_LOG_INFO(sqlStatement);
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(connection.driver(), sqlStatement,{SqlEntityConfigurer<ClassType>::tableName()}));
+            int position = 1;
+            for (const auto& id : idList)
+                id.bindTo(statement.get(), position++);
+            statement->execute();
+            return statement->nextRow();
+        }
+
+        static bool exists(SqlValue id) {
+            return exists({id});
+        }
+
+        /** 
+         * @brief Returns the sum of the ***field*** of the entities matching ***query***, which is zero if none does.
+         * Integral fields are summed as 64-bit integers and floating point fields as doubles.
+         */
+        template<typename AccessorType>
+        static typename std::conditional<std::is_floating_point<FieldType<AccessorType>>::value, double, std::int64_t>::type
+        sum(AccessorType field, const SqlQuery<ClassType>& query = SqlQuery<ClassType>()) {
+            static_assert(std::is_arithmetic<FieldType<AccessorType>>::value, "error: only arithmetic fields can be summed.");
+            using SumType = typename std::conditional<std::is_floating_point<FieldType<AccessorType>>::value, double, std::int64_t>::type;
+
+            SumType result = 0;
+            // TOTAL is the floating point sum which is 0.0 rather than NULL over no rows.
+            aggregate(std::is_floating_point<SumType>::value ? "TOTAL" : "SUM", qualifiedColumn(field), std::string(), query, [&result](const SqlStatement * statement) {
+                if (!statement->isNull(0))
+                    readSum(statement, &result);
+            });
+            return result;
+        }
+
+        /** 
+         * @brief Returns the least ***field*** of the entities matching ***query***, or a value-initialized one if none does.
+         */
+        template<typename AccessorType>
+        static FieldType<AccessorType> min(AccessorType field, const SqlQuery<ClassType>& query = SqlQuery<ClassType>()) {
+            return extremum<FieldType<AccessorType>>("MIN", qualifiedColumn(field), query);
+        }
+
+        /** 
+         * @brief Returns the greatest ***field*** of the entities matching ***query***, or a value-initialized one if none does.
+         */
+        template<typename AccessorType>
+        static FieldType<AccessorType> max(AccessorType field, const SqlQuery<ClassType>& query = SqlQuery<ClassType>()) {
+            return extremum<FieldType<AccessorType>>("MAX", qualifiedColumn(field), query);
+        }
+
+        /** 
+         * @brief Returns the number of entities matching ***query*** for each distinct value of their ***field***.
+         * For example:
+         * {@code 
+         * std::map<int, std::size_t> ageCount = SqlRepository<User>::countBy(&User::mAge);
+         * }
+         */
+        template<typename AccessorType>
+        static std::map<FieldType<AccessorType>, std::size_t> countBy(AccessorType field, const SqlQuery<ClassType>& query = SqlQuery<ClassType>()) {
+            std::map<FieldType<AccessorType>, std::size_t> result;
+            const std::string& column = qualifiedColumn(field);
+            aggregate("COUNT", "*", column, query, [&result](const SqlStatement * statement) {
+                FieldType<AccessorType> value = FieldType<AccessorType>();
+                if (!statement->isNull(0))
+                    Utility::statementToVariable(statement, 0, &value);
+                result[value] = static_cast<std::size_t> (statement->getInt64(1));
+            });
+            return result;
+        }
+
+        /** 
+         * @brief Returns a lazy, single-pass range over all the entities of the table.
+         * Rows are fetched and hydrated one at a time into a single instance owned by the stream as the range 
+         * is iterated, so memory use doesn't grow with the size of the table and the first entity is available 
+         * as soon as its row is. Relations are skipped, see Stream. The stream keeps a read connection checked 
+         * out until it is destroyed. For example:
+         * {@code 
+         * for (const User& user : SqlRepository<User>::stream())
+         *  std::cout << user.name() << std::endl;
+         * }
+         * @throw Exception if no primary field is configured.
+         */
+        static Stream stream() {
+            return stream(SqlQuery<ClassType>());
+        }
+
+        /** 
+         * @brief Returns a lazy, single-pass range over the entities matching ***query***, in its order, hydrating only the fields it selects if it is a projection.
+         * Relations are hydrated only if ***query*** requests them by SqlQuery#withRelations().
+         * @throw Exception if no primary field is configured.
+         * @see stream()
+         */
+        static Stream stream(const SqlQuery<ClassType>& query) {
+            if (SqlEntityConfigurer<ClassType>::primaryFieldList().size() == 0)
+                throw Exception("Could not fetch data, no primary field is configured.");
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+
+            Projection projection = project(query);
+
+            // the instances of relations read for each row would pile up in the caller's hands, so they are read on request only.
+            if (!query.isProjection() && !query.isRequestingRelations()) {
+                projection.selection = SqlGenerator::fetchAll(SqlEntityConfigurer<ClassType>::tableName());
+                projection.tableNameList.assign(1, SqlEntityConfigurer<ClassType>::tableName());
+                projection.isFetchingRelations = false;
+            }
+
+            const std::string& sqlStatement = query.text(projection.selection);
+            SALSABIL_LOG_INFO(sqlStatement);
+
+            std::unique_ptr<SqlStatement> statement(connection->createStatement(sqlStatement));
+            query.bind(statement.get());
+            statement->execute();
+
+            return Stream(std::move(connection), std::move(statement), std::move(projection));
+        }
+
+        /** 
+         * @brief Calls ***callback*** with each entity of the table, hydrating one row at a time into a single reused instance.
+         * The instance passed to ***callback*** is overwritten by the next row, so it must be copied if it is needed afterwards.
+         * @see stream()
+         */
+        template<typename Callback>
+        static void forEach(Callback callback) {
+            for (ClassType& instance : stream())
+                callback(instance);
+        }
+
+        static void persist(const ClassType * instance) {
+            insert(instance, false);
+        }
+
+        /** 
+         * @brief Persists ***instance*** like persist(), but returns false instead of throwing if it violates a constraint of the table, 
+         * e.g. its primary key is already taken, in which case nothing is written, its cascaded relations included.
+         * @throw Exception if no field is configured or any other error occurs.
+         */
+        static bool tryPersist(const ClassType * instance) {
+            return insert(instance, true);
         }
 
         static void update(const ClassType * instance) {
-            SqlDriver* driver = SqlEntityConfigurer<ClassType>::driver();
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            // cascaded operations are committed or rolled back along with the instance.
+            SqlTransaction transaction(driver);
 
             for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
                 relation->update(instance);
 
-            std::map<std::string, std::string> primaryColumnValueMap;
-            for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList())
-                primaryColumnValueMap.insert({field->name(), field->fetchFromInstance(instance).toString()});
+            const SqlStatementTemplate<ClassType>& statement = SqlEntityConfigurer<ClassType>::updateStatement();
+            if (statement.isEmpty()) {
+                transaction.commit();
+                invalidateTables(driver);
+                invalidate(driver, instance);
+                return;
+            }
+
+            SALSABIL_LOG_INFO(statement.text());
 
-            std::map<std::string, std::string> columnValueMap;
-            for (auto field : SqlEntityConfigurer<ClassType>::fieldList())
-                columnValueMap.insert({field->name(), field->fetchFromInstance(instance).toString()});
+            std::unique_ptr<SqlStatement> sqlStatement(driver->createStatement(statement.text()));
+            statement.bind(sqlStatement.get(), instance);
+            sqlStatement->execute();
+
+            transaction.commit();
+            invalidateTables(driver);
+            invalidate(driver, instance);
+        }
+
+        /** 
+         * @struct Snapshot
+         * @brief Snapshot holds the column values of an entity as taken by snapshot(), against which update(instance, snapshot) finds the changed columns.
+         */
+        struct Snapshot {
+            /// The values the update statement binds from the entity, by their placeholder positions.
+            std::map<int, SqlValue> bindingMap;
+        };
+
+        /// Returns the current column values of ***instance***, e.g. as it is hydrated, to be compared by update(instance, snapshot) later.
+        static Snapshot snapshot(const ClassType * instance) {
+            SqlBindingRecorder recorder;
+            SqlEntityConfigurer<ClassType>::updateStatement().bind(&recorder, instance);
+            return Snapshot{recorder.bindingMap()};
+        }
 
-            for (auto field : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList()) {
-                auto m = field->parseFrom(instance);
-                columnValueMap.insert(m.begin(), m.end());
+        /** 
+         * @brief Updates only the columns of ***instance*** whose values differ from ***snapshot***, then takes the snapshot again.
+         * No statement is executed for an instance which hasn't changed, so updating a wide row whose single column changed 
+         * costs as much as updating that column alone. The instances held by relations aren't snapshotted, so relations 
+         * cascading updates are updated as by update() even if none of the columns of ***instance*** changed.
+         * For example:
+         * {@code 
+         * User* user = SqlRepository<User>::fetch(42);
+         * SqlRepository<User>::Snapshot snapshot = SqlRepository<User>::snapshot(user);
+         * user->setLoginCount(user->loginCount() + 1);
+         * SqlRepository<User>::update(user, &snapshot);
+         * }
+         * @return true if a statement updating the row has been executed.
+         */
+        static bool update(const ClassType * instance, Snapshot* snapshot) {
+            Snapshot currentSnapshot = SqlRepository::snapshot(instance);
+
+            // the placeholders of the update statement hold the non-primary columns in order, followed by the primary ones.
+            const std::vector<std::string>& columnList = SqlEntityConfigurer<ClassType>::columnNameList();
+            const std::size_t primaryColumnCount = SqlEntityConfigurer<ClassType>::primaryFieldList().size();
+            const std::size_t updateColumnCount = SqlEntityConfigurer<ClassType>::updateStatement().isEmpty() ? 0 : columnList.size() - primaryColumnCount;
+
+            std::vector<int> changedPositionList;
+            std::vector<std::string> changedColumnList;
+            for (std::size_t idx = 0; idx < updateColumnCount; ++idx) {
+                const int position = idx + 1;
+                auto iter = snapshot->bindingMap.find(position);
+                if (iter == snapshot->bindingMap.end() || iter->second != currentSnapshot.bindingMap.at(position)) {
+                    changedPositionList.push_back(position);
+                    changedColumnList.push_back(columnList.at(primaryColumnCount + idx));
+                }
             }
 
-            const std::string& sqlStatement = SqlGenerator::update(SqlEntityConfigurer<ClassType>::tableName(), columnValueMap, primaryColumnValueMap);
+            bool isCascadingUpdate = false;
+            for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
+                isCascadingUpdate = isCascadingUpdate || relation->cascadesUpdate();
 
-            SALSABIL_LOG_INFO(sqlStatement);
+            if (changedColumnList.empty() && !isCascadingUpdate) {
+                *snapshot = std::move(currentSnapshot);
+                return false;
+            }
 
-            driver->execute(sqlStatement);
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            // cascaded operations are committed or rolled back along with the instance.
+            SqlTransaction transaction(driver);
+
+            for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
+                relation->update(instance);
+
+            if (!changedColumnList.empty()) {
+                const std::vector<std::string> primaryColumnList(columnList.begin(), columnList.begin() + primaryColumnCount);
+                const std::string& sqlStatement = SqlGenerator::preparedUpdate(SqlEntityConfigurer<ClassType>::tableName(), changedColumnList, primaryColumnList);
+                SALSABIL_LOG_INFO(sqlStatement);
+
+                std::unique_ptr<SqlStatement> statement(driver->createStatement(sqlStatement));
+                int position = 1;
+                for (int changedPosition : changedPositionList)
+                    currentSnapshot.bindingMap.at(changedPosition).bindTo(statement.get(), position++);
+                for (std::size_t idx = 0; idx < primaryColumnCount; ++idx)
+                    currentSnapshot.bindingMap.at(updateColumnCount + idx + 1).bindTo(statement.get(), position++);
+                statement->execute();
+            }
+
+            transaction.commit();
+            if (!changedColumnList.empty()) {
+                invalidateTables(driver);
+                invalidate(driver, instance);
+            }
+            *snapshot = std::move(currentSnapshot);
+            return !changedColumnList.empty();
         }
 
         static void remove(const ClassType * instance) {
-            SqlDriver* driver = SqlEntityConfigurer<ClassType>::driver();
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            // cascaded operations are committed or rolled back along with the instance.
+            SqlTransaction transaction(driver);
 
             for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
                 relation->remove(instance);
 
-            std::map<std::string, std::string> primaryColumnValueMap;
-            for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList())
-                primaryColumnValueMap.insert({field->name(), field->fetchFromInstance(instance).toString()});
+            const SqlStatementTemplate<ClassType>& statement = SqlEntityConfigurer<ClassType>::removeStatement();
+            if (statement.isEmpty())
+                throw Exception("Could not remove data, no primary field is configured.");
+
+            SALSABIL_LOG_INFO(statement.text());
+
+            std::unique_ptr<SqlStatement> sqlStatement(driver->createStatement(statement.text()));
+            statement.bind(sqlStatement.get(), instance);
+            sqlStatement->execute();
+
+            transaction.commit();
+            invalidateTables(driver);
+            invalidate(driver, instance);
+        }
+
+
+        /** 
+         * @brief Persists the instances in the range [***first***, ***last***) in a single transaction.
+         * The instances are inserted by multi-row INSERT statements of at most a hundred rows each, fewer if the 
+         * placeholder limit of the driver does not allow that many. The range may hold either instances or pointers to instances.
+         */
+        template<typename Iterator>
+        static void persistAll(Iterator first, Iterator last) {
+            insertAll(first, last, false);
+        }
+
+        /// Persists the instances, or pointers to instances, held in ***instanceList*** in a single transaction.
+        template<typename Container>
+        static void persistAll(const Container& instanceList) {
+            persistAll(std::begin(instanceList), std::end(instanceList));
+        }
+
+        /** 
+         * @brief Inserts ***instance***, or updates the row with its primary key if there is one already, by a single statement.
+         * Unlike persist() and update(), only the row of the entity is written, its relations held by other tables aren't cascaded. For example:
+         * {@code 
+         * User user(42, "Ali");
+         * SqlRepository<User>::save(&user);
+         * user.setName("Amir");
+         * SqlRepository<User>::save(&user);
+         * }
+         * @throw Exception if no primary field is configured.
+         */
+        static void save(const ClassType * instance) {
+            const SqlStatementTemplate<ClassType>& statement = SqlEntityConfigurer<ClassType>::upsertStatement();
+            if (statement.isEmpty())
+                throw Exception("Could not save data, no primary field is configured.");
+
+            SALSABIL_LOG_INFO(statement.text());
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
 
-            const std::string& sqlStatement = SqlGenerator::remove(SqlEntityConfigurer<ClassType>::tableName(), primaryColumnValueMap);
+            std::unique_ptr<SqlStatement> sqlStatement(driver->createStatement(statement.text()));
+            statement.bind(sqlStatement.get(), instance);
+            sqlStatement->execute();
 
+            invalidateTables(driver);
+            writeThrough(driver, instance);
+        }
+
+        /** 
+         * @brief Saves the instances in the range [***first***, ***last***) in a single transaction, by multi-row statements like persistAll().
+         * @see save()
+         */
+        template<typename Iterator>
+        static void saveAll(Iterator first, Iterator last) {
+            insertAll(first, last, true);
+        }
+
+        /// Saves the instances, or pointers to instances, held in ***instanceList*** in a single transaction.
+        template<typename Container>
+        static void saveAll(const Container& instanceList) {
+            saveAll(std::begin(instanceList), std::end(instanceList));
+        }
+
+        /** 
+         * @brief Updates the instances in the range [***first***, ***last***) in a single transaction, reusing one prepared statement.
+         * The range may hold either instances or pointers to instances.
+         */
+        template<typename Iterator>
+        static void updateAll(Iterator first, Iterator last) {
+            const SqlStatementTemplate<ClassType>& statement = SqlEntityConfigurer<ClassType>::updateStatement();
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            SqlTransaction transaction(driver);
+
+            std::unique_ptr<SqlStatement> sqlStatement;
+            if (!statement.isEmpty())
+                sqlStatement.reset(driver->createStatement(statement.text()));
+
+            std::vector<const ClassType*> cachedInstanceList;
+
+            for (; first != last; ++first) {
+                const ClassType* instance = instancePointer(*first);
+
+                for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
+                    relation->update(instance);
+
+                if (sqlStatement) {
+                    SALSABIL_LOG_INFO(statement.text());
+                    sqlStatement->reset();
+                    statement.bind(sqlStatement.get(), instance);
+                    sqlStatement->execute();
+                }
+
+                if (entityCache())
+                    cachedInstanceList.push_back(instance);
+            }
+
+            transaction.commit();
+            invalidateTables(driver);
+            for (auto instance : cachedInstanceList)
+                invalidate(driver, instance);
+        }
+
+        /// Updates the instances, or pointers to instances, held in ***instanceList*** in a single transaction.
+        template<typename Container>
+        static void updateAll(const Container& instanceList) {
+            updateAll(std::begin(instanceList), std::end(instanceList));
+        }
+
+        /** 
+         * @brief Removes the instances in the range [***first***, ***last***) in a single transaction, reusing one prepared statement.
+         * The range may hold either instances or pointers to instances.
+         */
+        template<typename Iterator>
+        static void removeAll(Iterator first, Iterator last) {
+            const SqlStatementTemplate<ClassType>& statement = SqlEntityConfigurer<ClassType>::removeStatement();
+            if (statement.isEmpty())
+                throw Exception("Could not remove data, no primary field is configured.");
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            SqlTransaction transaction(driver);
+
+            std::unique_ptr<SqlStatement> sqlStatement(driver->createStatement(statement.text()));
+
+            std::vector<const ClassType*> cachedInstanceList;
+
+            for (; first != last; ++first) {
+                const ClassType* instance = instancePointer(*first);
+
+                for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
+                    relation->remove(instance);
+
+                SALSABIL_LOG_INFO(statement.text());
+                sqlStatement->reset();
+                statement.bind(sqlStatement.get(), instance);
+                sqlStatement->execute();
+
+                if (entityCache())
+                    cachedInstanceList.push_back(instance);
+            }
+
+            transaction.commit();
+            invalidateTables(driver);
+            for (auto instance : cachedInstanceList)
+                invalidate(driver, instance);
+        }
+
+        /// Removes the instances, or pointers to instances, held in ***instanceList*** in a single transaction.
+        template<typename Container>
+        static void removeAll(const Container& instanceList) {
+            removeAll(std::begin(instanceList), std::end(instanceList));
+        }
+
+    private:
+
+        // inserts instance after its cascaded relations, returning false if it violates a constraint and isConflictTolerated.
+        static bool insert(const ClassType * instance, bool isConflictTolerated) {
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            // cascaded operations are committed or rolled back along with the instance.
+            SqlTransaction transaction(driver);
+
+            for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
+                relation->writeToDriver(driver, instance);
+
+            const SqlStatementTemplate<ClassType>& statement = SqlEntityConfigurer<ClassType>::insertStatement();
+            if (statement.isEmpty())
+                throw Exception("Could not persist data, no field is configured.");
+
+            SALSABIL_LOG_INFO(statement.text());
+
+            std::unique_ptr<SqlStatement> sqlStatement(driver->createStatement(statement.text()));
+            statement.bind(sqlStatement.get(), instance);
+            // the transaction rolls the cascaded writes back on going out of scope.
+            if (!isConflictTolerated)
+                sqlStatement->execute();
+            else if (!sqlStatement->tryExecute())
+                return false;
+
+            transaction.commit();
+            invalidateTables(driver);
+            writeThrough(driver, instance);
+            return true;
+        }
+
+        // inserts the instances in the range by chunks of rows, or upserts them if isUpsert.
+        template<typename Iterator>
+        static void insertAll(Iterator first, Iterator last, bool isUpsert) {
+            const SqlStatementTemplate<ClassType>& statement = isUpsert ? SqlEntityConfigurer<ClassType>::upsertStatement() : SqlEntityConfigurer<ClassType>::insertStatement();
+            if (statement.isEmpty())
+                throw Exception(isUpsert ? "Could not save data, no primary field is configured." : "Could not persist data, no field is configured.");
+
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::writeConnection();
+            SqlDriver* driver = connection.driver();
+
+            SqlTransaction transaction(driver);
+
+            // compiling a statement gets slower than executing it as its row count grows, so chunks are kept small.
+            const std::size_t maxChunkSize = 100;
+            const std::size_t chunkSize = std::max<std::size_t>(1, std::min<std::size_t>(maxChunkSize, driver->maxPlaceholderCount() / statement.placeholderCount()));
+            const std::vector<std::string> columnList = SqlEntityConfigurer<ClassType>::columnNameList();
+            std::vector<std::string> primaryColumnList;
+            for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                primaryColumnList.push_back(f->name());
+
+            std::vector<const ClassType*> chunk;
+            std::vector<const ClassType*> cachedInstanceList;
+            std::string sqlStatement;
+            std::unique_ptr<SqlStatement> chunkStatement;
+
+            while (first != last) {
+                chunk.clear();
+                for (; first != last && chunk.size() < chunkSize; ++first)
+                    chunk.push_back(instancePointer(*first));
+
+                // a saved row may be either inserted or updated, so it doesn't cascade to the relations of other tables.
+                if (!isUpsert) {
+                    for (auto instance : chunk) {
+                        for (auto relation : SqlEntityConfigurer<ClassType>::transientFieldList())
+                            relation->writeToDriver(driver, instance);
+                    }
+                }
+
+                // all the chunks but the last one are of the same size, so they share a single statement.
+                if (!chunkStatement || chunk.size() != chunkSize) {
+                    sqlStatement = isUpsert ?
+                            SqlGenerator::preparedUpsert(SqlEntityConfigurer<ClassType>::tableName(), columnList, primaryColumnList, chunk.size()) :
+                            SqlGenerator::preparedInsert(SqlEntityConfigurer<ClassType>::tableName(), columnList, chunk.size());
+                    chunkStatement.reset(driver->createStatement(sqlStatement));
+                } else {
+                    chunkStatement->reset();
+                }
+
+                SALSABIL_LOG_INFO(sqlStatement);
+
+                int position = 1;
+                for (auto instance : chunk)
+                    position = statement.bind(chunkStatement.get(), instance, position);
+                chunkStatement->execute();
+
+                if (entityCache())
+                    cachedInstanceList.insert(cachedInstanceList.end(), chunk.begin(), chunk.end());
+            }
+
+            transaction.commit();
+            invalidateTables(driver);
+            for (auto instance : cachedInstanceList)
+                writeThrough(driver, instance);
+        }
+
+        template<typename AccessorType>
+        static std::string qualifiedColumn(AccessorType field) {
+            return SqlEntityConfigurer<ClassType>::tableName() + "." + SqlEntityConfigurer<ClassType>::columnName(field);
+        }
+
+        // runs the aggregate function of column over the rows matching query, grouped by groupColumn if it isn't empty, 
+        // and passes each row of the result to reader. Only the table of the entity is read, so relations are never joined.
+        // The order and limit of query pick the rows aggregated, so a sorted or limited query is run as a subquery aliased 
+        // by the table name, which keeps the qualified columns valid; otherwise they would apply to the aggregated rows.
+        template<typename Reader>
+        static void aggregate(const std::string& function, const std::string& column, const std::string& groupColumn, const SqlQuery<ClassType>& query, Reader reader) {
+            const std::string& tableName = SqlEntityConfigurer<ClassType>::tableName();
+            const std::vector<std::string>& groupList = groupColumn.empty() ? std::vector<std::string>() : std::vector<std::string>{groupColumn};
+            std::string sqlStatement;
+            if (query.isLimited() || query.isOrdered())
+                sqlStatement = SqlGenerator::preparedSelect(SqlGenerator::aggregate("(" + query.text(SqlGenerator::fetchAll(tableName)) + ") AS " + tableName, function, column, groupColumn),
+                    std::vector<std::string>(), std::vector<std::string>(), 0, groupList);
+            else
+                sqlStatement = query.text(SqlGenerator::aggregate(tableName, function, column, groupColumn), groupList);
             SALSABIL_LOG_INFO(sqlStatement);
 
-            driver->execute(sqlStatement);
+            SqlConnectionPool::Connection connection = SqlEntityConfigurer<ClassType>::readConnection();
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(connection.driver(), sqlStatement,{tableName}));
+            query.bind(statement.get());
+            statement->execute();
+            while (statement->nextRow())
+                reader(statement.get());
+        }
+
+        static void readSum(const SqlStatement* statement, std::int64_t* to) {
+            *to = statement->getInt64(0);
+        }
+
+        static void readSum(const SqlStatement* statement, double* to) {
+            *to = statement->getDouble(0);
+        }
+
+        template<typename ResultType>
+        static ResultType extremum(const std::string& function, const std::string& column, const SqlQuery<ClassType>& query) {
+            ResultType result = ResultType();
+            aggregate(function, column, std::string(), query, [&result](const SqlStatement * statement) {
+                if (!statement->isNull(0))
+                    Utility::statementToVariable(statement, 0, &result);
+            });
+            return result;
+        }
+
+        // the projection of the whole entity, without its selection.
+        static Projection entityProjection() {
+            Projection projection;
+            projection.isPartial = false;
+            projection.isFetchingRelations = true;
+            return projection;
         }
 
+        // the projection of query, which selects either the fields chosen by the query or the whole entity.
+        static Projection project(const SqlQuery<ClassType>& query) {
+            if (!query.isProjection()) {
+                Projection projection = entityProjection();
+                projection.selection = selection();
+                projection.tableNameList = selectionTableList();
+                return projection;
+            }
+
+            Projection projection;
+            projection.isPartial = true;
+            projection.isFetchingRelations = query.isFetchingRelations();
+
+            const std::string& tableName = SqlEntityConfigurer<ClassType>::tableName();
+            const std::vector<std::string>& projectionList = query.projectionList();
+            std::vector<std::string> columnList;
+            for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList()) {
+                projection.fieldList.push_back({f, columnList.size()});
+                columnList.push_back(tableName + "." + f->name());
+            }
+            for (const auto& f : SqlEntityConfigurer<ClassType>::fieldList()) {
+                if (std::find(projectionList.begin(), projectionList.end(), f->name()) == projectionList.end())
+                    continue;
+                projection.fieldList.push_back({f, columnList.size()});
+                columnList.push_back(tableName + "." + f->name());
+            }
+            if (projection.isFetchingRelations) {
+                for (const auto& f : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList()) {
+                    projection.relationalFieldList.push_back({f, columnList.size()});
+                    for (const auto& column : f->columnNameList())
+                        columnList.push_back(tableName + "." + column);
+                }
+            }
+
+            projection.selection = "SELECT " + Utility::join(columnList.begin(), columnList.end(), ", ") + " FROM " + tableName;
+            projection.tableNameList.push_back(tableName);
+            return projection;
+        }
+
+        // hydrates the entities of at most maxCount rows of statement, along with their relations fetched by a join.
+        static std::vector<ClassType*> readRows(SqlStatement* statement, SqlDriver* driver, const Projection& projection, std::size_t maxCount) {
+            std::vector<ClassType*> instanceList;
+            while (instanceList.size() < maxCount && statement->nextRow()) {
+                ClassType* instance;
+                ClassType* pInstance = Utility::initializeInstance(&instance);
+                hydrateColumns(statement, driver, projection, pInstance);
+                instanceList.push_back(instance);
+            }
+            return instanceList;
+        }
+
+        // each of the other relations is loaded for all the instances at once, rather than by a query per instance.
+        static void readRelations(SqlDriver* driver, const Projection& projection, const std::vector<ClassType*>& instanceList) {
+            if (!projection.isFetchingRelations)
+                return;
+
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (projection.isPartial || !r->isJoinFetched())
+                    r->readAllFromDriver(driver, instanceList);
+            }
+        }
+
+        // encodes the primary key of instance as the type, the size and the text of each of its values, e.g. "i2:42t3:Ali". 
+        // Reals are written with enough digits to be read back exactly.
+        static std::string encodeKey(const ClassType* instance) {
+            std::string key;
+            for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList()) {
+                const SqlValue& value = f->fetchFromInstance(instance);
+                std::string text;
+                char type = 't';
+                switch (value.type()) {
+                    case SqlValue::Type::Integer:
+                        type = 'i';
+                        text = std::to_string(value.toInt64());
+                        break;
+                    case SqlValue::Type::Real:
+                    {
+                        type = 'r';
+                        char digits[32];
+                        std::snprintf(digits, sizeof (digits), "%.17g", value.toDouble());
+                        text = digits;
+                        break;
+                    }
+                    case SqlValue::Type::Blob:
+                        type = 'b';
+                        text = value.text();
+                        break;
+                    default:
+                        text = value.text();
+                        break;
+                }
+                key += type + std::to_string(text.size()) + ':' + text;
+            }
+            return key;
+        }
+
+        static std::vector<SqlValue> decodeKey(const std::string& key) {
+            std::vector<SqlValue> valueList;
+            std::size_t pos = 0;
+            while (pos < key.size()) {
+                const char type = key[pos++];
+                const std::size_t colon = key.find(':', pos);
+                if ((type != 'i' && type != 'r' && type != 't' && type != 'b') || colon == std::string::npos || colon == pos ||
+                        key.find_first_not_of("0123456789", pos) != colon)
+                    throw Exception("malformed continuation token: " + key);
+
+                // the token comes from the client, so a length too large for stoul is malformed rather than a std exception.
+                std::size_t size = 0;
+                try {
+                    size = std::stoul(key.substr(pos, colon - pos));
+                } catch (const std::exception&) {
+                    throw Exception("malformed continuation token: " + key);
+                }
+                if (size > key.size() - colon - 1)
+                    throw Exception("malformed continuation token: " + key);
+
+                const std::string& text = key.substr(colon + 1, size);
+                if ((type == 'i' && !isInteger(text)) || (type == 'r' && !isNumber(text)))
+                    throw Exception("malformed continuation token: " + key);
+
+                if (type == 'i')
+                    valueList.push_back(SqlValue(std::stoll(text)));
+                else if (type == 'r')
+                    valueList.push_back(SqlValue(std::stod(text)));
+                else if (type == 'b')
+                    valueList.push_back(SqlValue::blob(text.data(), text.size()));
+                else
+                    valueList.push_back(SqlValue(text));
+                pos = colon + 1 + size;
+            }
+
+            if (valueList.size() != SqlEntityConfigurer<ClassType>::primaryFieldList().size())
+                throw Exception("malformed continuation token: " + key);
+            return valueList;
+        }
+
+        static bool isInteger(const std::string& text) {
+            if (text.find_first_not_of("-0123456789") != std::string::npos)
+                return false;
+            try {
+                std::size_t size = 0;
+                std::stoll(text, &size);
+                return size == text.size();
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+
+        static bool isNumber(const std::string& text) {
+            try {
+                std::size_t size = 0;
+                std::stod(text, &size);
+                return size == text.size();
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+
+        // hydrates the fields of instance selected by projection out of the current row, along with the relations fetched by a join.
+        static void hydrateColumns(SqlStatement* statement, SqlDriver* driver, const Projection& projection, ClassType* instance) {
+            if (projection.isPartial) {
+                for (const auto& f : projection.fieldList)
+                    f.first->readFromStatement(statement, instance, f.second);
+                for (const auto& f : projection.relationalFieldList)
+                    f.first->injectInto(statement, instance, f.second);
+                return;
+            }
+
+            for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                f->readFromStatement(statement, instance, f->column());
+            for (const auto& f : SqlEntityConfigurer<ClassType>::fieldList())
+                f->readFromStatement(statement, instance, f->column());
+            for (const auto& f : SqlEntityConfigurer<ClassType>::relationalPersistentFieldList())
+                f->injectInto(statement, instance);
+            if (projection.isFetchingRelations)
+                readJoinFetchedRelations(statement, driver, instance);
+        }
+
+        static void hydrate(SqlStatement* statement, SqlDriver* driver, const Projection& projection, ClassType* instance) {
+            hydrateColumns(statement, driver, projection, instance);
+            if (!projection.isFetchingRelations)
+                return;
+
+            // a partial projection doesn't join the tables of the relations, so all of them are read by their own queries.
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (projection.isPartial || !r->isJoinFetched())
+                    r->readFromDriver(driver, instance);
+            }
+        }
+
+        // the entity cache, if there is any and the entities have no relations that cached copies would share.
+        static SqlEntityCache<ClassType>* entityCache() {
+            SqlEntityCache<ClassType>* cache = SqlEntityConfigurer<ClassType>::entityCache();
+            if (cache && (!SqlEntityConfigurer<ClassType>::transientFieldList().empty() || !SqlEntityConfigurer<ClassType>::relationalPersistentFieldList().empty())) {
+                static std::once_flag isLogged;
+                std::call_once(isLogged, []() {
+                    SALSABIL_LOG_INFO("The entity cache of table '" + SqlEntityConfigurer<ClassType>::tableName() + "' is ignored, entities with relations are not cached");
+                });
+                return nullptr;
+            }
+            return cache;
+        }
+
+        // caches a written instance, unless the write may still be rolled back by an enclosing transaction.
+        static void writeThrough(SqlDriver* driver, const ClassType* instance) {
+            SqlEntityCache<ClassType>* cache = entityCache();
+            if (!cache)
+                return;
+
+            const std::string& key = SqlEntityConfigurer<ClassType>::primaryKey(instance);
+            if (driver->isInTransaction())
+                cache->invalidate(driver, key);
+            else
+                cache->put(key, *instance);
+        }
+
+        // within an enclosing transaction, other threads may still cache the committed row, so the entry is invalidated again as the transaction ends.
+        static void invalidate(SqlDriver* driver, const ClassType* instance) {
+            if (SqlEntityCache<ClassType>* cache = entityCache())
+                cache->invalidate(driver, SqlEntityConfigurer<ClassType>::primaryKey(instance));
+        }
+
+        // bumps the versions of the tables written by the repository and its cascading relations in the query caches.
+        static void invalidateTables(SqlDriver* driver) {
+            SqlQueryCache::invalidateTable(driver, SqlEntityConfigurer<ClassType>::tableName());
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                for (const auto& tableName : r->tableNameList())
+                    SqlQueryCache::invalidateTable(driver, tableName);
+            }
+        }
+
+        static bool hasJoinFetchedRelation() {
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (r->isJoinFetched())
+                    return true;
+            }
+            return false;
+        }
+
+        static std::string joinAlias(std::size_t index) {
+            return "salsabil_join_" + std::to_string(index);
+        }
+
+        // selects all the rows of the table, joined with the tables of the relations fetched by a join if there are any.
+        static std::string selection() {
+            const std::string& tableName = SqlEntityConfigurer<ClassType>::tableName();
+            if (!hasJoinFetchedRelation())
+                return SqlGenerator::fetchAll(tableName);
+
+            // the joined columns follow the columns of the table, in the order of the relations.
+            std::vector<std::string> columnList{tableName + ".*"};
+            std::vector<std::string> joinClauseList;
+            std::size_t index = 0;
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (!r->isJoinFetched())
+                    continue;
+                const std::string& alias = joinAlias(index++);
+                const std::vector<std::string>& joinColumnList = r->joinColumnList(alias);
+                columnList.insert(columnList.end(), joinColumnList.begin(), joinColumnList.end());
+                joinClauseList.push_back(r->joinClause(alias));
+            }
+            return "SELECT " + Utility::join(columnList.begin(), columnList.end(), ", ") + " FROM " + tableName + " " +
+                    Utility::join(joinClauseList.begin(), joinClauseList.end(), " ");
+        }
+
+        // the tables read by selection().
+        static std::vector<std::string> selectionTableList() {
+            std::vector<std::string> tableNameList{SqlEntityConfigurer<ClassType>::tableName()};
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (r->isJoinFetched())
+                    tableNameList.push_back(r->tableName());
+            }
+            return tableNameList;
+        }
+
+        static std::string joinedFetchById() {
+            std::vector<std::string> conditionList;
+            for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                conditionList.push_back(SqlEntityConfigurer<ClassType>::tableName() + "." + f->name() + " = " + SqlGenerator::placeholder(conditionList.size() + 1));
+            return selection() + " WHERE " + Utility::join(conditionList.begin(), conditionList.end(), " AND ");
+        }
+
+        static void readJoinFetchedRelations(SqlStatement* statement, SqlDriver* driver, ClassType* instance) {
+            std::size_t joinColumnCount = 0;
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (r->isJoinFetched())
+                    joinColumnCount += r->joinColumnCount();
+            }
+
+            int column = statement->columnCount() - joinColumnCount;
+            for (const auto& r : SqlEntityConfigurer<ClassType>::transientFieldList()) {
+                if (!r->isJoinFetched())
+                    continue;
+                r->readFromJoin(driver, statement, column, instance);
+                column += r->joinColumnCount();
+            }
+        }
+
+        static const ClassType* instancePointer(const ClassType& instance) {
+            return &instance;
+        }
+
+        static const ClassType* instancePointer(const ClassType* instance) {
+            return instance;
+        }
     };
 }
 
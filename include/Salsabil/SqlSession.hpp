@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLSESSION_HPP
+#define SALSABIL_SQLSESSION_HPP
+
+#include "SqlEntityConfigurer.hpp"
+#include "SqlRepository.hpp"
+#include "internal/SqlValue.hpp"
+
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace Salsabil {
+
+    /** 
+     * @class SqlSession
+     * @brief SqlSession is a unit of work which keeps an identity map of the entities fetched through it.
+     * 
+     * Within a session, an entity is fetched from the database only once; fetching it again by the same primary key 
+     * returns the instance fetched first without touching the driver, so each row fetched through the session is 
+     * represented by a single instance. Instances fetched through a session are owned by it and deleted along with it, 
+     * unless they are evicted. 
+     * 
+     * The identity map covers the entities fetched by fetch() and fetchAll() only. The instances of their relations 
+     * are owned by the entities they are read into, as they are outside a session, so they are neither held by the 
+     * session nor looked up in it. As a limitation, a row reached through a relation is therefore represented by an 
+     * instance of its own, which may coexist with the instance of the same row held by the session. 
+     * For example:
+     * {@code 
+     * SqlSession session;
+     * User* user = session.fetch<User>(1);
+     * assert(session.fetch<User>(1) == user);
+     * }
+     * Unless change tracking is disabled, the session snapshots the instances it fetches, so that updating them through 
+     * the session writes only their changed columns, and nothing at all for their unchanged rows. Relations which 
+     * cascade updates are updated whether their owner has changed or not, since their instances aren't snapshotted. 
+     * A session is not thread-safe; it is meant to be used by a single thread at a time.
+     */
+    class SqlSession {
+    public:
+
+        SqlSession() : mIsTrackingChanges(true) {
+        }
+
+        SqlSession(const SqlSession&) = delete;
+
+        SqlSession& operator=(const SqlSession&) = delete;
+
+        /// Deletes all the instances held by the session.
+        ~SqlSession() {
+        }
+
+        /** 
+         * @brief Returns the instance of ***ClassType*** with the primary key values ***idList***, fetching it only if the session doesn't hold it yet.
+         * @throw Exception if the instance isn't held and couldn't be fetched.
+         */
+        template<typename ClassType>
+        ClassType* fetch(std::initializer_list<SqlValue> idList) {
+            IdentityMap<ClassType>& identityMap = identityMapOf<ClassType>();
+            const std::string& key = SqlEntityConfigurer<ClassType>::primaryKey(idList);
+
+            auto iter = identityMap.instanceMap.find(key);
+            if (iter != identityMap.instanceMap.end())
+                return iter->second.get();
+
+            ClassType* instance = SqlRepository<ClassType>::fetch(idList);
+            identityMap.instanceMap[key].reset(instance);
+            if (mIsTrackingChanges)
+                identityMap.snapshotMap[key] = SqlRepository<ClassType>::snapshot(instance);
+            return instance;
+        }
+
+        /// Returns the instance of ***ClassType*** with the primary key value ***id***, fetching it only if the session doesn't hold it yet.
+        template<typename ClassType>
+        ClassType* fetch(SqlValue id) {
+            return fetch<ClassType>({id});
+        }
+
+        /** 
+         * @brief Fetches all the entities of ***ClassType***. 
+         * The rows of instances the session already holds are represented by the held instances, whose rows aren't hydrated 
+         * again, others are added to the session.
+         */
+        template<typename ClassType>
+        std::vector<ClassType*> fetchAll() {
+            IdentityMap<ClassType>& identityMap = identityMapOf<ClassType>();
+
+            std::vector<ClassType*> instanceList = SqlRepository<ClassType>::fetchAll([&identityMap](const std::string & key) -> ClassType* {
+                auto iter = identityMap.instanceMap.find(key);
+                return iter == identityMap.instanceMap.end() ? nullptr : iter->second.get();
+            });
+            for (auto instance : instanceList) {
+                const std::string& key = SqlEntityConfigurer<ClassType>::primaryKey(instance);
+                std::unique_ptr<ClassType>& heldInstance = identityMap.instanceMap[key];
+                if (!heldInstance) {
+                    heldInstance.reset(instance);
+                    if (mIsTrackingChanges)
+                        identityMap.snapshotMap[key] = SqlRepository<ClassType>::snapshot(instance);
+                }
+            }
+            return instanceList;
+        }
+
+        /// Checks whether the session holds the instance of ***ClassType*** with the primary key values ***idList***.
+        template<typename ClassType>
+        bool contains(std::initializer_list<SqlValue> idList) const {
+            auto iter = mIdentityMapMap.find(std::type_index(typeid (ClassType)));
+            if (iter == mIdentityMapMap.end())
+                return false;
+            return static_cast<IdentityMap<ClassType>*> (iter->second.get())->instanceMap.count(SqlEntityConfigurer<ClassType>::primaryKey(idList)) > 0;
+        }
+
+        /// Checks whether the session holds the instance of ***ClassType*** with the primary key value ***id***.
+        template<typename ClassType>
+        bool contains(SqlValue id) const {
+            return contains<ClassType>({id});
+        }
+
+        /** 
+         * @brief Removes ***instance*** from the session without deleting it, so that it is owned by the caller afterwards.
+         * The next fetch of the same primary key hits the database again.
+         */
+        template<typename ClassType>
+        void evict(ClassType* instance) {
+            IdentityMap<ClassType>& identityMap = identityMapOf<ClassType>();
+            auto iter = identityMap.instanceMap.find(SqlEntityConfigurer<ClassType>::primaryKey(instance));
+            if (iter == identityMap.instanceMap.end() || iter->second.get() != instance)
+                return;
+            iter->second.release();
+            identityMap.instanceMap.erase(iter);
+            identityMap.snapshotMap.erase(SqlEntityConfigurer<ClassType>::primaryKey(instance));
+        }
+
+        /** 
+         * @brief Enables or disables the snapshotting of the instances fetched from now on, which lets update() skip their unchanged columns.
+         * Change tracking is enabled by default. Disabling it spares the snapshot taken as each instance is fetched, 
+         * e.g. for sessions which only read. Instances held already keep their snapshots, if any.
+         */
+        void setChangeTracking(bool isTrackingChanges) {
+            mIsTrackingChanges = isTrackingChanges;
+        }
+
+        /// Checks whether the session snapshots the instances it fetches.
+        bool isTrackingChanges() const {
+            return mIsTrackingChanges;
+        }
+
+        /** 
+         * @brief Updates ***instance***, writing only the columns changed since it was fetched if the session has snapshotted it.
+         * Instances which aren't snapshotted, e.g. because they were fetched without change tracking, are updated entirely. 
+         * The relations of a snapshotted instance whose columns are unchanged are still updated if they cascade updates, as by SqlRepository#update(instance, snapshot).
+         * @return false if the instance is snapshotted and unchanged, so no statement updating its row has been executed.
+         */
+        template<typename ClassType>
+        bool update(ClassType* instance) {
+            IdentityMap<ClassType>& identityMap = identityMapOf<ClassType>();
+            const std::string& key = SqlEntityConfigurer<ClassType>::primaryKey(instance);
+
+            auto instanceIter = identityMap.instanceMap.find(key);
+            auto snapshotIter = identityMap.snapshotMap.find(key);
+            if (instanceIter == identityMap.instanceMap.end() || instanceIter->second.get() != instance || snapshotIter == identityMap.snapshotMap.end()) {
+                SqlRepository<ClassType>::update(instance);
+                return true;
+            }
+            return SqlRepository<ClassType>::update(instance, &snapshotIter->second);
+        }
+
+        /// Returns the number of instances held by the session.
+        std::size_t size() const {
+            std::size_t count = 0;
+            for (const auto& identityMapPair : mIdentityMapMap)
+                count += identityMapPair.second->size();
+            return count;
+        }
+
+        /// Deletes all the instances held by the session.
+        void clear() {
+            mIdentityMapMap.clear();
+        }
+
+    private:
+
+        struct IdentityMapBase {
+
+            virtual ~IdentityMapBase() {
+            }
+
+            virtual std::size_t size() const = 0;
+        };
+
+        template<typename ClassType>
+        struct IdentityMap : public IdentityMapBase {
+            std::map<std::string, std::unique_ptr<ClassType>> instanceMap;
+            std::map<std::string, typename SqlRepository<ClassType>::Snapshot> snapshotMap;
+
+            virtual std::size_t size() const {
+                return instanceMap.size();
+            }
+        };
+
+        template<typename ClassType>
+        IdentityMap<ClassType>& identityMapOf() {
+            std::unique_ptr<IdentityMapBase>& identityMap = mIdentityMapMap[std::type_index(typeid (ClassType))];
+            if (!identityMap)
+                identityMap.reset(new IdentityMap<ClassType>());
+            return *static_cast<IdentityMap<ClassType>*> (identityMap.get());
+        }
+
+        std::map<std::type_index, std::unique_ptr<IdentityMapBase>> mIdentityMapMap;
+        bool mIsTrackingChanges;
+    };
+}
+#endif // SALSABIL_SQLSESSION_HPP
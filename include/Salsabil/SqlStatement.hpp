@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLSTATEMENT_HPP
+#define SALSABIL_SQLSTATEMENT_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace Salsabil {
+
+    /** 
+     * @struct SqlStringView
+     * @brief SqlStringView refers to a string value of the current row without copying it.
+     * 
+     * The string is not necessarily null-terminated; ***data*** is null for NULL values. The view is valid 
+     * until the statement is stepped, reset or destroyed.
+     */
+    struct SqlStringView {
+        const char* data;
+        std::size_t size;
+
+        /// Returns a copy of the referred string.
+        std::string toStdString() const {
+            return data ? std::string(data, size) : std::string();
+        }
+    };
+
+    /** 
+     * @struct SqlBlobSpan
+     * @brief SqlBlobSpan refers to a blob value of the current row without copying it.
+     * 
+     * ***data*** is null for NULL and empty values. The span is valid until the statement is stepped, reset or destroyed.
+     */
+    struct SqlBlobSpan {
+        const void* data;
+        std::size_t size;
+    };
+
+    /** 
+     * @class SqlStatement
+     * @brief SqlStatement is an abstract base class for a single prepared SQL statement and the cursor over its result set.
+     * 
+     * Statements are created by SqlDriver#createStatement() and are owned by the caller. Each statement 
+     * has its own bindings and its own current row, so several statements can be stepped on the same 
+     * connection at the same time, e.g. a nested query can be executed for each row of an outer query 
+     * without disturbing it. For example:
+     * {@code 
+     * std::unique_ptr<SqlStatement> outer(sd.createStatement("SELECT id FROM user"));
+     * std::unique_ptr<SqlStatement> inner(sd.createStatement("SELECT name FROM phone WHERE user_id = ?"));
+     * outer->execute();
+     * while (outer->nextRow()) {
+     *  inner->reset();
+     *  inner->bindInt(1, outer->getInt(0));
+     *  inner->execute();
+     *  while (inner->nextRow())
+     *      std::cout << inner->getStdString(0) << std::endl;
+     * }
+     * }
+     * A statement must be destroyed before the driver that created it.
+     */
+    class SqlStatement {
+    public:
+
+        virtual ~SqlStatement() {
+        }
+
+        /** 
+         * @brief Executes the statement.
+         * @throw Exception if an error occurred while trying to execute the statement. 
+         */
+        virtual void execute() = 0;
+
+        /** 
+         * @brief Executes the statement like execute(), but reports a violated constraint, e.g. a duplicate primary key, 
+         * by returning false instead of throwing, since such a conflict is an expected outcome of some writes.
+         * @retval true if the statement is executed.
+         * @retval false if the statement violates a constraint and has no effect.
+         * @throw Exception if any other error occurred while trying to execute the statement. 
+         */
+        virtual bool tryExecute() = 0;
+
+        /**  
+         * @brief Fetches the next row from the result set if available.
+         * @retval true if a row is fetched.
+         * @retval false if there is no further row to be fetched.
+         * @throw Exception if an error occurred while trying to fetch the row. 
+         */
+        virtual bool nextRow() = 0;
+
+        /// Resets the statement and clears its bindings, so that it can be bound and executed again.
+        virtual void reset() = 0;
+
+        /// Returns the number of columns in the result set of the statement.
+        virtual int columnCount() const = 0;
+
+        /**  
+         * @name Result Retrieving Functions
+         * @brief These functions retrieve the field values from the current row of the result set of the executed query.
+         * @param columnIndex the index of the field column in the current row that needs to be retrieved.
+         */
+        //@{
+        /**  
+         * @brief Checks whether the value of the field ***columnIndex*** in the current row is NULL.
+         * @retval true if the value is NULL.
+         * @retval false otherwise.
+         */
+        virtual bool isNull(int columnIndex) const = 0;
+
+        /// Returns the integer value of the field ***columnIndex*** in the current row.
+        virtual int getInt(int columnIndex) const = 0;
+
+        /// Returns the 64bit-integer value of the field ***columnIndex*** in the current row.
+        virtual int64_t getInt64(int columnIndex) const = 0;
+
+        /// Returns the float value of the field ***columnIndex*** in the current row.
+        virtual float getFloat(int columnIndex) const = 0;
+
+        /// Returns the double value of the field ***columnIndex*** in the current row.
+        virtual double getDouble(int columnIndex) const = 0;
+
+        /// Returns the string value of the field ***columnIndex*** in the current row as raw data pointer.
+        virtual const unsigned char* getRawString(int columnIndex) const = 0;
+
+        /// Returns the string value of the field ***columnIndex*** in the current row as a C-string.
+        virtual const char* getCString(int columnIndex) const = 0;
+
+        /// Returns the string value of the field ***columnIndex*** in the current row as a STL-string.
+        virtual std::string getStdString(int columnIndex) const = 0;
+
+        /// Returns the value size of the field ***columnIndex*** in the current row in bytes.
+        virtual std::size_t getSize(int columnIndex) const = 0;
+
+        /// Returns the blob value of the field ***columnIndex*** in the current row as a void pointer.
+        virtual const void* getBlob(int columnIndex) const = 0;
+
+        /// Returns the string value of the field ***columnIndex*** in the current row along with its size, without copying it.
+        virtual SqlStringView getStringView(int columnIndex) const {
+            const char* data = getCString(columnIndex);
+            return SqlStringView{data, getSize(columnIndex)};
+        }
+
+        /// Returns the blob value of the field ***columnIndex*** in the current row along with its size, without copying it.
+        virtual SqlBlobSpan getBlobSpan(int columnIndex) const {
+            const void* data = getBlob(columnIndex);
+            return SqlBlobSpan{data, getSize(columnIndex)};
+        }
+        //@}
+
+        /**  
+         * @name Binding Functions
+         * @brief These functions bind parameter values to positional placeholders in the SQL statement 
+         * text that are of the form ?NNN where NNN is an integer between 1 and 999 specifies the position of the placeholder.
+         * @param position the position of the placeholder that needs to be replaced.
+         * @throw Exception if the parameter couldn't be bound or ***position*** is out of range. 
+         */
+        //@{
+        /// Binds a NULL to the placeholder at ***position***.
+        virtual void bindNull(int position) const = 0;
+
+        /// Binds an integer to the placeholder at ***position***.
+        virtual void bindInt(int position, int value) const = 0;
+
+        /// Binds a 64bit integer to the placeholder at ***position***.
+        virtual void bindInt64(int position, int64_t value) const = 0;
+
+        /// Binds a float to the placeholder at ***position***.
+        virtual void bindFloat(int position, float value) const = 0;
+
+        /// Binds a double to the placeholder at ***position***.
+        virtual void bindDouble(int position, double value) const = 0;
+
+        /// Binds a C literal string to the placeholder at ***position***.
+        virtual void bindCString(int position, const char* str) const = 0;
+
+        /// Binds a standard literal string to the placeholder at ***position***.
+        virtual void bindStdString(int position, const std::string& str) const = 0;
+
+        /// Binds a non-typed array ***blob*** of length ***size*** to the placeholder at ***position***.
+        virtual void bindBlob(int position, const void* blob, std::size_t size) const = 0;
+        //@}
+    };
+}
+#endif // SALSABIL_SQLSTATEMENT_HPP
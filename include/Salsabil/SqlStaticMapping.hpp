@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLSTATICMAPPING_HPP
+#define SALSABIL_SQLSTATICMAPPING_HPP
+
+#include "SqlDriver.hpp"
+#include "SqlQueryCache.hpp"
+#include "SqlTransaction.hpp"
+#include "internal/SqlGenerator.hpp"
+#include "internal/SqlStaticColumn.hpp"
+#include "internal/SqlValue.hpp"
+#include "internal/StringHelper.hpp"
+#include "internal/Logging.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Salsabil {
+
+    /** 
+     * @class SqlStaticMapping
+     * @brief SqlStaticMapping maps the columns of a table to the fields of a class at compile time.
+     * 
+     * It is an alternative to configuring the fields by SqlEntityConfigurer for plain entities read in bulk. 
+     * The columns are held in a tuple whose type describes every field, so reading a row into an entity and 
+     * binding an entity to a statement are unrolled into direct calls, without the virtual field and access 
+     * wrapper calls of the configured fields. Attributes are read and bound in place. Relations, caches and 
+     * sessions are not supported, and entities are returned by value, though persistAll() invalidates the results 
+     * of the query caches read from the table like the repositories do. Reading rows measured 1.1x to 1.25x faster 
+     * than through the configured fields, whereas persisting showed no consistent gain, since executing the 
+     * statements dominates its cost; see bench/SqlMappingBenchmark.cpp. For example:
+     * {@code 
+     * static const auto mapping = makeSqlStaticMapping<User>("user",
+     *      sqlColumn("id", &User::id),
+     *      sqlColumn("name", &User::getName, &User::setName));
+     * std::vector<User> userList = mapping.fetchAll(driver, "age > ?", {30});
+     * }
+     */
+    template<class ClassType, typename... ColumnTypes>
+    class SqlStaticMapping {
+        std::string mTableName;
+        std::tuple<ColumnTypes...> mColumnTuple;
+        std::vector<std::string> mColumnNameList;
+        std::string mSelection;
+
+        using ColumnVisitor = Utility::TupleVisitor<0, sizeof...(ColumnTypes)>;
+
+        struct RowReader {
+            const SqlStatement* statement;
+            ClassType* instance;
+            int firstColumn;
+
+            template<typename ColumnType>
+            void operator()(const ColumnType& column, int index) {
+                column.read(statement, instance, firstColumn + index);
+            }
+        };
+
+        struct RowBinder {
+            SqlStatement* statement;
+            const ClassType* instance;
+            int firstPosition;
+
+            template<typename ColumnType>
+            void operator()(const ColumnType& column, int index) {
+                column.write(statement, instance, firstPosition + index);
+            }
+        };
+
+        struct NameCollector {
+            std::vector<std::string>* nameList;
+
+            template<typename ColumnType>
+            void operator()(const ColumnType& column, int) {
+                nameList->push_back(column.name());
+            }
+        };
+
+    public:
+
+        SqlStaticMapping(const std::string& tableName, const ColumnTypes&... columns) : mTableName(tableName), mColumnTuple(columns...) {
+            NameCollector collector{&mColumnNameList};
+            ColumnVisitor::visit(mColumnTuple, collector);
+            mSelection = "SELECT " + Utility::join(mColumnNameList.begin(), mColumnNameList.end(), ", ") + " FROM " + mTableName;
+        }
+
+        const std::string& tableName() const {
+            return mTableName;
+        }
+
+        /// Returns the names of the mapped columns, in the order they are read and bound.
+        const std::vector<std::string>& columnNameList() const {
+            return mColumnNameList;
+        }
+
+        /// Reads the fields of ***instance*** from the current row of ***statement***, starting at the column ***firstColumn***.
+        void readRow(const SqlStatement* statement, ClassType* instance, int firstColumn = 0) const {
+            RowReader reader{statement, instance, firstColumn};
+            ColumnVisitor::visit(mColumnTuple, reader);
+        }
+
+        /// Binds the fields of ***instance*** to ***statement*** starting at ***firstPosition***, and returns the position following them.
+        int bindRow(SqlStatement* statement, const ClassType* instance, int firstPosition = 1) const {
+            RowBinder binder{statement, instance, firstPosition};
+            ColumnVisitor::visit(mColumnTuple, binder);
+            return firstPosition + static_cast<int> (sizeof...(ColumnTypes));
+        }
+
+        /** 
+         * @brief Returns the entities of the rows satisfying ***condition***, or of all the rows if it is empty.
+         * The condition is an SQL expression whose placeholders are bound to ***parameterList*** in order, e.g. "age > ?".
+         */
+        std::vector<ClassType> fetchAll(SqlDriver* driver, const std::string& condition = std::string(), const std::vector<SqlValue>& parameterList = std::vector<SqlValue>()) const {
+            const std::string& sqlStatement = condition.empty() ? mSelection : mSelection + " WHERE " + condition;
+            SALSABIL_LOG_INFO(sqlStatement);
+
+            std::unique_ptr<SqlStatement> statement(driver->createStatement(sqlStatement));
+            for (std::size_t idx = 0; idx < parameterList.size(); ++idx)
+                parameterList[idx].bindTo(statement.get(), static_cast<int> (idx) + 1);
+            statement->execute();
+
+            std::vector<ClassType> instanceList;
+            while (statement->nextRow()) {
+                instanceList.emplace_back();
+                readRow(statement.get(), &instanceList.back());
+            }
+            return instanceList;
+        }
+
+        /// Inserts the entities in the range [***first***, ***last***) in a single transaction, several rows per statement.
+        template<typename Iterator>
+        void persistAll(SqlDriver* driver, Iterator first, Iterator last) const {
+            SqlTransaction transaction(driver);
+
+            // the chunks are as large as those of SqlRepository#persistAll(), and all of them but the last one share a single statement.
+            const std::size_t maxChunkSize = 100;
+            const std::size_t chunkSize = std::max<std::size_t>(1, std::min<std::size_t>(maxChunkSize, driver->maxPlaceholderCount() / sizeof...(ColumnTypes)));
+            std::vector<const ClassType*> chunk;
+            std::string sqlStatement;
+            std::unique_ptr<SqlStatement> chunkStatement;
+
+            while (first != last) {
+                chunk.clear();
+                for (; first != last && chunk.size() < chunkSize; ++first)
+                    chunk.push_back(&*first);
+
+                if (!chunkStatement || chunk.size() != chunkSize) {
+                    sqlStatement = SqlGenerator::preparedInsert(mTableName, mColumnNameList, chunk.size());
+                    chunkStatement.reset(driver->createStatement(sqlStatement));
+                } else {
+                    chunkStatement->reset();
+                }
+
+                SALSABIL_LOG_INFO(sqlStatement);
+
+                int position = 1;
+                for (auto instance : chunk)
+                    position = bindRow(chunkStatement.get(), instance, position);
+                chunkStatement->execute();
+            }
+
+            transaction.commit();
+            SqlQueryCache::invalidateTable(driver, mTableName);
+        }
+
+        template<typename Container>
+        void persistAll(SqlDriver* driver, const Container& instanceList) const {
+            persistAll(driver, std::begin(instanceList), std::end(instanceList));
+        }
+    };
+
+    /// Returns a column named ***name*** mapped to ***attribute***.
+    template<class ClassType, typename FieldType>
+    SqlStaticAttributeColumn<ClassType, FieldType> sqlColumn(const std::string& name, FieldType ClassType::* attribute) {
+        return SqlStaticAttributeColumn<ClassType, FieldType>(name, attribute);
+    }
+
+    /// Returns a column named ***name*** mapped to ***getter*** and ***setter***.
+    template<class ClassType, typename FieldType, typename SetMethodType>
+    SqlStaticMethodColumn<ClassType, FieldType(ClassType::*)() const, SetMethodType> sqlColumn(const std::string& name, FieldType(ClassType::*getter)() const, SetMethodType setter) {
+        return SqlStaticMethodColumn<ClassType, FieldType(ClassType::*)() const, SetMethodType>(name, getter, setter);
+    }
+
+    /// Returns the mapping of the table ***tableName*** to ***ClassType***, whose columns are ***columns*** in order.
+    template<class ClassType, typename... ColumnTypes>
+    SqlStaticMapping<ClassType, ColumnTypes...> makeSqlStaticMapping(const std::string& tableName, const ColumnTypes&... columns) {
+        return SqlStaticMapping<ClassType, ColumnTypes...>(tableName, columns...);
+    }
+}
+
+#endif // SALSABIL_SQLSTATICMAPPING_HPP
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLTRANSACTION_HPP
+#define SALSABIL_SQLTRANSACTION_HPP
+
+#include "SqlDriver.hpp"
+#include "Exception.hpp"
+#include "internal/Logging.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+
+namespace Salsabil {
+
+    /** 
+     * @class SqlTransaction
+     * @brief SqlTransaction is a scoped guard which groups the statements executed during its lifetime into a transaction.
+     * 
+     * The transaction is begun on construction and committed by commit(). If the guard goes out of scope 
+     * before being committed, e.g. because an exception has been thrown, the transaction is rolled back. 
+     * Guards can be nested: a guard constructed while a transaction is already in progress sets a savepoint 
+     * instead, so rolling it back only undoes the changes made during its own lifetime, and committing it 
+     * leaves the changes to be committed by the outer transaction. For example:
+     * {@code 
+     * SqlTransaction transaction(driver);
+     * SqlRepository<User>::persist(&user);
+     * SqlRepository<Session>::persist(&session);
+     * transaction.commit();
+     * }
+     */
+    class SqlTransaction {
+    public:
+
+        /** 
+         * @brief Begins a transaction on ***driver***, or sets a savepoint if a transaction is already in progress.
+         * @throw Exception if the transaction couldn't be begun. 
+         */
+        explicit SqlTransaction(SqlDriver* driver) : mDriver(driver), mIsActive(true) {
+            if (mDriver->isInTransaction()) {
+                mSavepointName = "salsabil_savepoint_" + std::to_string(nextSavepointId());
+                SALSABIL_LOG_DEBUG("Setting savepoint: " + mSavepointName);
+                mDriver->setSavepoint(mSavepointName);
+            } else {
+                SALSABIL_LOG_DEBUG("Beginning transaction");
+                mDriver->beginTransaction();
+            }
+        }
+
+        SqlTransaction(const SqlTransaction&) = delete;
+
+        SqlTransaction& operator=(const SqlTransaction&) = delete;
+
+        /// Rolls back the transaction if it is neither committed nor rolled back.
+        ~SqlTransaction() {
+            if (!mIsActive)
+                return;
+
+            try {
+                rollback();
+            } catch (const Exception& exp) {
+                std::cerr << exp.what() << std::endl;
+            }
+        }
+
+        /** 
+         * @brief Commits the transaction, or releases the savepoint of a nested guard.
+         * @throw Exception if the guard is not active anymore or the transaction couldn't be committed. 
+         */
+        void commit() {
+            if (!mIsActive)
+                throw Exception("transaction has already been finished");
+
+            if (isSavepoint()) {
+                mDriver->releaseSavepoint(mSavepointName);
+            } else {
+                mDriver->commit();
+            }
+
+            mIsActive = false;
+        }
+
+        /** 
+         * @brief Rolls back the transaction, or the changes done since the savepoint of a nested guard.
+         * @throw Exception if the guard is not active anymore or the transaction couldn't be rolled back. 
+         */
+        void rollback() {
+            if (!mIsActive)
+                throw Exception("transaction has already been finished");
+
+            mIsActive = false;
+
+            if (isSavepoint()) {
+                mDriver->rollbackToSavepoint(mSavepointName);
+                mDriver->releaseSavepoint(mSavepointName);
+            } else {
+                // a failing statement may have rolled back the transaction already, leaving its end to be signaled here.
+                if (mDriver->isInTransaction())
+                    mDriver->rollback();
+                else
+                    mDriver->finishTransaction();
+            }
+        }
+
+        /// Returns whether the transaction is neither committed nor rolled back yet.
+        bool isActive() const {
+            return mIsActive;
+        }
+
+        /// Returns whether this guard has set a savepoint inside an enclosing transaction.
+        bool isSavepoint() const {
+            return !mSavepointName.empty();
+        }
+
+    private:
+
+        static unsigned long nextSavepointId() {
+            static std::atomic<unsigned long> savepointId(0);
+            return ++savepointId;
+        }
+
+        SqlDriver* mDriver;
+        std::string mSavepointName;
+        bool mIsActive;
+    };
+}
+
+#endif // SALSABIL_SQLTRANSACTION_HPP
@@ -24,10 +24,13 @@
 
 #include "SqlDriver.hpp"
 
+#include <memory>
+
 struct sqlite3;
 struct sqlite3_stmt;
 
 namespace Salsabil {
+    class SqliteStatement;
 
     /** 
      * @class SqliteDriver
@@ -62,7 +65,7 @@ namespace Salsabil {
      * After executing SQL queries, you can iterate over the result set using nextRow() 
      * and access the individual field values of the current row by using the methods 
      * isNull(), getInt(), getInt64(), getDouble(), getRawString(), getCString(), 
-     * getStdString(), getSize(), getBlob().
+     * getStdString(), getSize(), getBlob(), getStringView(), getBlobSpan().
      * 
      * Each field is accessed by passing the field's position in the statement, starting from 0. 
      * The fields are numbered from left to right in the same order as the corresponding columns 
@@ -97,6 +100,16 @@ namespace Salsabil {
      * ...
      * }
      * }
+     * 
+     * Prepared statements are kept in a least-recently-used cache keyed by their SQL text. 
+     * Preparing a statement whose text is found in the cache resets and reuses the already 
+     * compiled statement instead of parsing and planning it again. The cache capacity can be 
+     * changed by setStatementCacheCapacity(), and its effectiveness can be observed through 
+     * statementCacheHitCount() and statementCacheMissCount().
+     * 
+     * The functions above work on a single current statement. To step several statements on 
+     * the same connection at the same time, e.g. to run a query for each row of another one, 
+     * create independent statements through createStatement().
      */
     class SqliteDriver : public SqlDriver {
     public:
@@ -131,6 +144,14 @@ namespace Salsabil {
          */
         virtual void close();
 
+        /** 
+         * @brief Creates an independent statement out of the SQL statement ***sqlStatement***.
+         * The statement is taken from the statement cache if possible, and is given back to it once destroyed. 
+         * The caller takes ownership of the statement and must destroy it before closing the connection.
+         * @throw Exception if an error occurred while trying to prepare the statement. 
+         */
+        virtual SqlStatement* createStatement(const std::string& sqlStatement);
+
         /** 
          * @brief Prepares the SQL statement sqlStatement for execution.
          * The statement may contain placeholders for binding values. Currently, only 
@@ -201,6 +222,12 @@ namespace Salsabil {
 
         /// Returns the blob value of the field ***columnIndex*** in the current row as a void pointer.
         virtual const void* getBlob(int columnIndex) const;
+
+        /// Returns the string value of the field ***columnIndex*** in the current row along with its size, without copying it.
+        virtual SqlStringView getStringView(int columnIndex) const;
+
+        /// Returns the blob value of the field ***columnIndex*** in the current row along with its size, without copying it.
+        virtual SqlBlobSpan getBlobSpan(int columnIndex) const;
         //@}
 
         /**  
@@ -237,19 +264,70 @@ namespace Salsabil {
         virtual void bindBlob(int position, const void* blob, std::size_t size) const;
         //@}
 
+        /**  
+         * @brief Checks whether a transaction is in progress.
+         * @retval true if a transaction has been begun and is not committed or rolled back yet.
+         * @retval false if the connection is in autocommit mode.
+         */
+        virtual bool isInTransaction() const;
+
+        /// Returns the maximum number of placeholders a single statement may contain on this connection.
+        virtual int maxPlaceholderCount() const;
+
+        /** 
+         * @brief Makes concurrent connections wait for each other's locks, and switches the writer to WAL mode or makes the reader query-only.
+         * @throw Exception if the settings couldn't be applied.
+         */
+        virtual void configurePooledConnection(bool isReader);
+
         /// Returns a list(as a vector of strings) containing the existing database tables.
         virtual std::vector<std::string> tableList();
 
         /// Returns a list(as a vector of strings) containing the columns of the table ***table*** in order.
         virtual std::vector<std::string> columnList(const std::string& table);
 
+        /**  
+         * @name Statement Cache Functions
+         * @brief These functions control and inspect the cache of prepared statements.
+         */
+        //@{
+        /** 
+         * @brief Sets the maximum number of prepared statements kept in the cache to ***capacity***.
+         * The least recently used statements are finalized if the cache exceeds the new capacity. 
+         * A capacity of 0 disables the cache.
+         */
+        void setStatementCacheCapacity(std::size_t capacity);
+
+        /// Returns the maximum number of prepared statements kept in the cache.
+        std::size_t statementCacheCapacity() const;
+
+        /// Returns the number of prepared statements currently kept in the cache.
+        std::size_t statementCacheSize() const;
+
+        /// Returns the number of times a statement has been reused from the cache.
+        std::size_t statementCacheHitCount() const;
+
+        /// Returns the number of times a statement has been compiled because it was not found in the cache.
+        std::size_t statementCacheMissCount() const;
+        //@}
+
+        /// The default maximum number of prepared statements kept in the cache.
+        static const std::size_t DefaultStatementCacheCapacity = 32;
+
     private:
-        void finalize();
+        friend class SqliteStatement;
+        struct StatementCache;
+
+        sqlite3_stmt* acquireStatement(const std::string& sqlStatement);
+        void releaseStatement(sqlite3_stmt* statement);
+        void evictStatements(std::size_t capacity);
 
         sqlite3* mHandle;
-        sqlite3_stmt* mStatement;
-        bool mNextFetchFlag;
-        bool mDelayCycleFlag;
+        std::unique_ptr<SqliteStatement> mStatement;
+        std::unique_ptr<StatementCache> mStatementCache;
+        std::size_t mStatementCacheCapacity;
+        std::size_t mStatementCacheHitCount;
+        std::size_t mStatementCacheMissCount;
     };
 }
 #endif // SALSABIL_SQLITEDRIVER_HPP
@@ -22,6 +22,10 @@
 #ifndef SALSABIL_ACCESSWRAPPER_HPP
 #define SALSABIL_ACCESSWRAPPER_HPP
 
+#include <type_traits>
+#include <utility>
+#include "TypeHelper.hpp"
+
 namespace Salsabil {
 
     template<class ClassType, typename FieldType>
@@ -29,6 +33,8 @@ namespace Salsabil {
     public:
         virtual void get(const ClassType*, FieldType*) = 0;
         virtual void set(ClassType*, FieldType*) = 0;
+        // like set(), but the field instance may be moved from, so it is left in a valid but unspecified state.
+        virtual void move(ClassType*, FieldType*) = 0;
     };
 
     template<class ClassType, typename FieldType, typename AttributeType>
@@ -46,10 +52,16 @@ namespace Salsabil {
         virtual void set(ClassType* classInstance, FieldType* fieldInstance) {
             classInstance->*mAttributePtr = *fieldInstance;
         }
+
+        virtual void move(ClassType* classInstance, FieldType* fieldInstance) {
+            classInstance->*mAttributePtr = std::move(*fieldInstance);
+        }
     };
 
     template<class ClassType, typename FieldType, typename GetMethodType, typename SetMethodType>
     class AccessWrapperMethodImpl : public AccessWrapper<ClassType, FieldType> {
+        using SetterArgumentType = typename Utility::Traits<SetMethodType>::template argument<1>::type;
+
         GetMethodType mGetterPtr;
         SetMethodType mSetterPtr;
     public:
@@ -62,7 +74,14 @@ namespace Salsabil {
         }
 
         virtual void set(ClassType* classInstance, FieldType* fieldInstance) {
-            (classInstance->*mSetterPtr)(*fieldInstance);
+            // a setter taking an rvalue reference is given a copy, so that the field instance is left intact.
+            using CopyType = typename std::conditional<std::is_rvalue_reference<SetterArgumentType>::value, FieldType, FieldType&>::type;
+            (classInstance->*mSetterPtr)(static_cast<CopyType> (*fieldInstance));
+        }
+
+        virtual void move(ClassType* classInstance, FieldType* fieldInstance) {
+            // the field instance is passed as an rvalue to setters taking it by value or by rvalue reference, and as is otherwise.
+            (classInstance->*mSetterPtr)(static_cast<SetterArgumentType&&> (*fieldInstance));
         }
     };
 }
@@ -32,6 +32,12 @@ namespace Salsabil {
         All = 0xF
     };
 
+    /* How the instances of a relation are fetched along with their owner: by a query of their own (Select), 
+     * or from the same row as their owner by joining their table into the query of the owner (Join). */
+    enum class FetchType {
+        Select, Join
+    };
+
 }
 
 #endif // SALSABIL_DECLARATIONS_HPP
@@ -36,8 +36,14 @@
 #endif
 #endif
 
+// Either can be overridden from the build, e.g. -DSALSABIL_ENABLE_LOG_INFO=0.
+#ifndef SALSABIL_ENABLE_LOG_DEBUG
 #define SALSABIL_ENABLE_LOG_DEBUG 0
+#endif
+
+#ifndef SALSABIL_ENABLE_LOG_INFO
 #define SALSABIL_ENABLE_LOG_INFO  1
+#endif
 
 #if SALSABIL_ENABLE_LOG_DEBUG
 #define SALSABIL_LOG_DEBUG(ARG) std::cout << "\nSalsabil [debug] file: '" << __FILE__ << "', line: '"<< __LINE__ << "', function: \n" << CURRENT_FUNCTION_SIGNATURE << "\n"<< ARG << "\n";
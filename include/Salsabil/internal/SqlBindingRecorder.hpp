@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLBINDINGRECORDER_HPP
+#define SALSABIL_SQLBINDINGRECORDER_HPP
+
+#include "SqlStatement.hpp"
+#include "SqlValue.hpp"
+
+#include <map>
+#include <string>
+
+namespace Salsabil {
+
+    /* 
+     * SqlBindingRecorder is a statement which is never executed, it only records the values bound to it 
+     * by their positions, e.g. to take the values a statement template binds from an instance. 
+     */
+    class SqlBindingRecorder : public SqlStatement {
+    public:
+
+        const std::map<int, SqlValue>& bindingMap() const {
+            return mBindingMap;
+        }
+
+        void execute() override {
+        }
+
+        bool tryExecute() override {
+            return true;
+        }
+
+        bool nextRow() override {
+            return false;
+        }
+
+        void reset() override {
+            mBindingMap.clear();
+        }
+
+        int columnCount() const override {
+            return 0;
+        }
+
+        bool isNull(int) const override {
+            return true;
+        }
+
+        int getInt(int) const override {
+            return 0;
+        }
+
+        int64_t getInt64(int) const override {
+            return 0;
+        }
+
+        float getFloat(int) const override {
+            return 0;
+        }
+
+        double getDouble(int) const override {
+            return 0;
+        }
+
+        const unsigned char* getRawString(int) const override {
+            return nullptr;
+        }
+
+        const char* getCString(int) const override {
+            return nullptr;
+        }
+
+        std::string getStdString(int) const override {
+            return std::string();
+        }
+
+        std::size_t getSize(int) const override {
+            return 0;
+        }
+
+        const void* getBlob(int) const override {
+            return nullptr;
+        }
+
+        void bindNull(int position) const override {
+            mBindingMap[position] = SqlValue();
+        }
+
+        void bindInt(int position, int value) const override {
+            mBindingMap[position] = SqlValue(value);
+        }
+
+        void bindInt64(int position, int64_t value) const override {
+            mBindingMap[position] = SqlValue(value);
+        }
+
+        void bindFloat(int position, float value) const override {
+            mBindingMap[position] = SqlValue(value);
+        }
+
+        void bindDouble(int position, double value) const override {
+            mBindingMap[position] = SqlValue(value);
+        }
+
+        void bindCString(int position, const char* str) const override {
+            if (str)
+                mBindingMap[position] = SqlValue(std::string(str));
+            else
+                bindNull(position);
+        }
+
+        void bindStdString(int position, const std::string& str) const override {
+            mBindingMap[position] = SqlValue(str);
+        }
+
+        void bindBlob(int position, const void* blob, std::size_t size) const override {
+            mBindingMap[position] = SqlValue::blob(blob, size);
+        }
+
+    private:
+        mutable std::map<int, SqlValue> mBindingMap;
+    };
+}
+
+#endif // SALSABIL_SQLBINDINGRECORDER_HPP
@@ -42,11 +42,11 @@ namespace Salsabil {
 
         virtual SqlValue fetchFromInstance(const ClassType* instance) = 0;
 
-        /* Reads the data at the corresponding column from <i>driver</i> and inject it in <i>instance</i> using its setter method. */
-        virtual void readFromDriver(ClassType* instance, int column) = 0;
+        /* Reads the data at the corresponding column from <i>statement</i> and inject it in <i>instance</i> using its setter method. */
+        virtual void readFromStatement(SqlStatement* statement, ClassType* instance, int column) = 0;
 
-        /* Gets the data from <i>instance</i> via its getter method and writes it to <i>driver</i> at the corresponding column. */
-        virtual void writeToDriver(const ClassType* instance, int column) = 0;
+        /* Gets the data from <i>instance</i> via its getter method and binds it to <i>statement</i> at the corresponding placeholder position. */
+        virtual void writeToStatement(SqlStatement* statement, const ClassType* instance, int position) = 0;
 
         std::string name() const {
             return mName;
@@ -31,7 +31,7 @@
 #include <memory>
 
 namespace Salsabil {
-    class SqlDriver;
+    class SqlStatement;
 
     template<typename ClassType, typename FieldType>
     class SqlFieldImpl : public SqlField<ClassType> {
@@ -47,20 +47,20 @@ namespace Salsabil {
         virtual SqlValue fetchFromInstance(const ClassType* instance) {
             FieldType t;
             mAccessWrapper->get(instance, &t);
-            return SqlValue(t);
+            return Utility::variableToValue(t);
         }
 
-        virtual void readFromDriver(ClassType* instance, int columnIndex) {
-            SALSABIL_LOG_DEBUG("SqlFieldImpl, readFromDriver at column: " + std::to_string(columnIndex));
+        virtual void readFromStatement(SqlStatement* statement, ClassType* instance, int columnIndex) {
+            SALSABIL_LOG_DEBUG("SqlFieldImpl, readFromStatement at column: " + std::to_string(columnIndex));
             FieldType t;
-            Utility::driverToVariable(SqlEntityConfigurer<ClassType>::driver(), columnIndex, Utility::initializeInstance(&t));
-            mAccessWrapper->set(instance, &t);
+            Utility::statementToVariable(statement, columnIndex, Utility::initializeInstance(&t));
+            mAccessWrapper->move(instance, &t);
         }
 
-        virtual void writeToDriver(const ClassType* instance, int columnIndex) {
+        virtual void writeToStatement(SqlStatement* statement, const ClassType* instance, int position) {
             FieldType t;
             mAccessWrapper->get(instance, &t);
-            Utility::variableToDriver(SqlEntityConfigurer<ClassType>::driver(), columnIndex, Utility::pointerizeInstance(&t));
+            Utility::variableToStatement(statement, position, Utility::pointerizeInstance(&t));
         }
     };
 }
@@ -37,6 +37,9 @@ namespace Salsabil {
 
         static std::string fetchAll(const std::string& table);
 
+        // a query of the aggregate function, e.g. COUNT or MAX, of column over the rows of table, preceded by groupColumn if it isn't empty.
+        static std::string aggregate(const std::string& table, const std::string& function, const std::string& column, const std::string& groupColumn = std::string());
+
         static std::string fetchById(const std::string& table, const std::string& column, const std::string& id);
 
         static std::string fetchById(const std::string& table, const std::map<std::string, std::string >& columnValueMap);
@@ -53,6 +56,40 @@ namespace Salsabil {
         static std::string update(const std::string& table, const std::map<std::string, std::string>& columnValueMap, const std::map<std::string, std::string>& whereConditionMap);
 
         static std::string remove(const std::string& table, const std::map<std::string, std::string>& primaryColumnValueMap);
+
+        // The following functions generate statements with numbered placeholders (?NNN) instead of literal values. 
+        // Placeholders are numbered from 1 in the order of the given columns, so that values can be bound in the same order.
+
+        static std::string placeholder(int position);
+
+        static std::string preparedFetchById(const std::string& table, const std::vector<std::string>& columnList);
+
+        // a statement inserting rowCount rows at once, whose placeholders continue to be numbered from one row to the next.
+        static std::string preparedInsert(const std::string& table, const std::vector<std::string>& columnList, std::size_t rowCount = 1);
+
+        // a statement like preparedInsert() which updates the other columns of the rows whose conflictColumnList is already taken instead.
+        static std::string preparedUpsert(const std::string& table, const std::vector<std::string>& columnList, const std::vector<std::string>& conflictColumnList, std::size_t rowCount = 1);
+
+        static std::string preparedUpdate(const std::string& table, const std::vector<std::string>& columnList, const std::vector<std::string>& whereColumnList);
+
+        static std::string preparedRemove(const std::string& table, const std::vector<std::string>& whereColumnList);
+
+        // a condition matching columnList against any of rowCount rows of placeholders, using a row value for several columns.
+        static std::string preparedIn(const std::vector<std::string>& columnList, std::size_t rowCount, int firstPosition = 1);
+
+        // a query of whether table has a row whose columnList equals the placeholders.
+        static std::string preparedExists(const std::string& table, const std::vector<std::string>& columnList);
+
+        // a condition matching the rows whose columnList comes after the placeholders from firstPosition, using a row value for several columns.
+        static std::string preparedSeek(const std::vector<std::string>& columnList, int firstPosition = 1);
+
+        // the rows of the query selection matching all of conditionList, grouped by groupList and sorted by orderList. If limitPosition 
+        // isn't zero, the rows are limited by the placeholders at limitPosition and limitPosition + 1, which hold the limit and the offset.
+        static std::string preparedSelect(const std::string& selection, const std::vector<std::string>& conditionList, const std::vector<std::string>& orderList, int limitPosition = 0,
+                const std::vector<std::string>& groupList = std::vector<std::string>());
+
+    private:
+        static std::string preparedCondition(const std::vector<std::string>& columnList, int firstPosition, const std::string& delimiter);
     };
 }
 
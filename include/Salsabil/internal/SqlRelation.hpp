@@ -22,6 +22,12 @@
 #ifndef SALSABIL_SQLRELATION_HPP
 #define SALSABIL_SQLRELATION_HPP
 
+#include "SqlDriver.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace Salsabil {
 
     enum class RelationType {
@@ -45,12 +51,59 @@ namespace Salsabil {
         virtual void fetch(SqlDriver* driver, ClassType* classInstance) {
         }
 
+        /* Reads the relation of every instance in <i>classInstanceList</i>. Relations override it to load the related rows 
+         * of many instances by a single query, instead of a query per instance. */
+        virtual void readAllFromDriver(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) {
+            for (auto classInstance : classInstanceList)
+                readFromDriver(driver, classInstance);
+        }
+
+        /* The batched counterpart of fetch(). */
+        virtual void fetchAll(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) {
+            for (auto classInstance : classInstanceList)
+                fetch(driver, classInstance);
+        }
+
+        /* Relations fetched by a join are read from the row of their owner, whose query joins their table under <i>alias</i>. */
+        virtual bool isJoinFetched() const {
+            return false;
+        }
+
+        // the columns of the joined table selected by the query of the owner, each aliased by the name of the table alias.
+        virtual std::vector<std::string> joinColumnList(const std::string& /*alias*/) const {
+            return std::vector<std::string>();
+        }
+
+        // the number of columns in joinColumnList().
+        virtual std::size_t joinColumnCount() const {
+            return 0;
+        }
+
+        // the join of the table of the relation to the table of the owner.
+        virtual std::string joinClause(const std::string& /*alias*/) const {
+            return std::string();
+        }
+
+        // reads the relation of <i>classInstance</i> from the joined columns of <i>statement</i> starting at <i>firstColumn</i>.
+        virtual void readFromJoin(SqlDriver* /*driver*/, SqlStatement* /*statement*/, int /*firstColumn*/, ClassType* /*classInstance*/) {
+        }
+
+        // the tables the relation is read from, whose versions are bumped as the relation is written.
+        virtual std::vector<std::string> tableNameList() const {
+            return std::vector<std::string>(1, mTableName);
+        }
+
         virtual void persist(const ClassType* classInstance) {
         }
 
         virtual void update(const ClassType* classInstance) {
         }
 
+        // whether update() writes the related instances, which the owner's snapshot doesn't cover.
+        virtual bool cascadesUpdate() const {
+            return false;
+        }
+
         virtual void remove(const ClassType* classInstance) {
         }
 
@@ -70,6 +123,14 @@ namespace Salsabil {
             mType = type;
         }
 
+    protected:
+
+        // the number of instances whose keys, each of keyColumnCount columns, are bound to a single batched query.
+        static std::size_t batchSize(const SqlDriver* driver, std::size_t keyColumnCount) {
+            const std::size_t maxBatchSize = 500;
+            return std::max<std::size_t>(1, std::min<std::size_t>(maxBatchSize, driver->maxPlaceholderCount() / keyColumnCount));
+        }
+
     private:
         std::string mTableName;
         RelationType mType;
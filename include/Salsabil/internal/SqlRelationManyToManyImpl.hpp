@@ -31,6 +31,9 @@
 #include "SqlManyToManyMapping.hpp"
 #include "Logging.hpp"
 
+#include <map>
+#include <memory>
+
 namespace Salsabil {
     class SqlDriver;
 
@@ -59,52 +62,135 @@ namespace Salsabil {
             }
             std::vector<std::string> whereConditionList;
             for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList()) {
-                whereConditionList.push_back(mRelationMapping.intersectionTableName() + "." + mRelationMapping.backwardMapping(SqlEntityConfigurer<ClassType>::tableName(), field->name()) + " = " + field->fetchFromInstance(classInstance).toString());
+                whereConditionList.push_back(mRelationMapping.intersectionTableName() + "." + mRelationMapping.backwardMapping(SqlEntityConfigurer<ClassType>::tableName(), field->name()) + " = " + SqlGenerator::placeholder(whereConditionList.size() + 1));
             }
             const std::string& sqlStatement = "SELECT " + SqlEntityConfigurer<FieldItemPureType>::tableName() + ".* FROM " + SqlEntityConfigurer<FieldItemPureType>::tableName() + " INNER JOIN " + mRelationMapping.intersectionTableName() + " ON " +
                     Utility::join(onConditionList.begin(), onConditionList.end(), " AND ") + " WHERE " + Utility::join(whereConditionList.begin(), whereConditionList.end(), " AND ");
 
-            driver->execute(sqlStatement);
             SALSABIL_LOG_INFO(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, tableNameList()));
+            int position = 1;
+            for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                field->writeToStatement(statement.get(), classInstance, position++);
+            statement->execute();
 
             FieldType fieldInstanceContainer;
 
-            while (driver->nextRow()) {
+            while (statement->nextRow()) {
                 FieldItemType fieldInstance;
                 FieldItemPureType* pFieldInstance = Utility::initializeInstance(&fieldInstance);
                 for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList())
-                    f->readFromDriver(pFieldInstance, f->column());
+                    f->readFromStatement(statement.get(), pFieldInstance, f->column());
                 for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::fieldList())
-                    f->readFromDriver(pFieldInstance, f->column());
+                    f->readFromStatement(statement.get(), pFieldInstance, f->column());
 
-                fieldInstanceContainer.push_back(fieldInstance);
+                fieldInstanceContainer.push_back(std::move(fieldInstance));
             }
-            mAccessWrapper->set(classInstance, &fieldInstanceContainer);
+            mAccessWrapper->move(classInstance, &fieldInstanceContainer);
+        }
+
+        virtual void readAllFromDriver(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) override {
+            std::vector<std::string> onConditionList;
+            for (auto field : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList()) {
+                onConditionList.push_back(SqlEntityConfigurer<FieldItemPureType>::tableName() + "." + field->name() + " = " + mRelationMapping.intersectionTableName() + "." + mRelationMapping.backwardMapping(SqlEntityConfigurer<FieldItemPureType>::tableName(), field->name()));
+            }
+            std::vector<std::string> keyColumnList;
+            for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList()) {
+                keyColumnList.push_back(mRelationMapping.intersectionTableName() + "." + mRelationMapping.backwardMapping(SqlEntityConfigurer<ClassType>::tableName(), field->name()));
+            }
+
+            // the key columns of the intersection table are selected at the end of each row, to tell which instance the row belongs to.
+            const std::string& selection = "SELECT " + SqlEntityConfigurer<FieldItemPureType>::tableName() + ".*, " + Utility::join(keyColumnList.begin(), keyColumnList.end(), ", ") +
+                    " FROM " + SqlEntityConfigurer<FieldItemPureType>::tableName() + " INNER JOIN " + mRelationMapping.intersectionTableName() + " ON " +
+                    Utility::join(onConditionList.begin(), onConditionList.end(), " AND ") + " WHERE ";
+
+            std::map<std::string, FieldType> fieldInstanceContainerMap;
+
+            const std::size_t batchSize = SqlRelation<ClassType>::batchSize(driver, keyColumnList.size());
+            for (std::size_t first = 0; first < classInstanceList.size(); first += batchSize) {
+                const std::size_t count = std::min(batchSize, classInstanceList.size() - first);
+
+                const std::string& sqlStatement = selection + SqlGenerator::preparedIn(keyColumnList, count);
+
+                SALSABIL_LOG_INFO(sqlStatement);
+                std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, tableNameList()));
+                int position = 1;
+                for (std::size_t idx = first; idx < first + count; ++idx) {
+                    for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->writeToStatement(statement.get(), classInstanceList[idx], position++);
+                }
+                statement->execute();
+
+                const int keyColumn = statement->columnCount() - keyColumnList.size();
+                ClassType keyInstance;
+
+                while (statement->nextRow()) {
+                    FieldItemType fieldInstance;
+                    FieldItemPureType* pFieldInstance = Utility::initializeInstance(&fieldInstance);
+                    for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList())
+                        f->readFromStatement(statement.get(), pFieldInstance, f->column());
+                    for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::fieldList())
+                        f->readFromStatement(statement.get(), pFieldInstance, f->column());
+
+                    int column = keyColumn;
+                    for (auto field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->readFromStatement(statement.get(), &keyInstance, column++);
+
+                    fieldInstanceContainerMap[SqlEntityConfigurer<ClassType>::primaryKey(&keyInstance)].push_back(std::move(fieldInstance));
+                }
+            }
+
+            // each container is moved into the last instance sharing its key, and copied into the ones before it.
+            std::vector<std::string> keyList;
+            std::map<std::string, std::size_t> keySharingCountMap;
+            for (auto classInstance : classInstanceList) {
+                keyList.push_back(SqlEntityConfigurer<ClassType>::primaryKey(classInstance));
+                ++keySharingCountMap[keyList.back()];
+            }
+
+            for (std::size_t idx = 0; idx < classInstanceList.size(); ++idx) {
+                FieldType& fieldInstanceContainer = fieldInstanceContainerMap[keyList[idx]];
+                if (--keySharingCountMap[keyList[idx]] == 0)
+                    mAccessWrapper->move(classInstanceList[idx], &fieldInstanceContainer);
+                else
+                    mAccessWrapper->set(classInstanceList[idx], &fieldInstanceContainer);
+            }
+        }
+
+        virtual std::vector<std::string> tableNameList() const override {
+            return {SqlRelation<ClassType>::tableName(), mRelationMapping.intersectionTableName()};
         }
 
         virtual void writeToDriver(SqlDriver* driver, const ClassType* classInstance) {
+            std::vector<std::string> columnList;
+            for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                columnList.push_back(mRelationMapping.backwardMapping(SqlEntityConfigurer<ClassType>::tableName(), f->name()));
+            for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList())
+                columnList.push_back(mRelationMapping.backwardMapping(SqlEntityConfigurer<FieldItemPureType>::tableName(), f->name()));
+
+            const std::string& sqlStatement = SqlGenerator::preparedInsert(mRelationMapping.intersectionTableName(), columnList);
 
             FieldType fieldInstanceContainer;
             mAccessWrapper->get(classInstance, &fieldInstanceContainer);
 
-            typename FieldType::const_iterator iter = fieldInstanceContainer.begin();
-            while (iter != fieldInstanceContainer.end()) {
-                std::map<std::string, std::string> columnValueMap;
+            if (fieldInstanceContainer.empty())
+                return;
 
-                for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList()) {
-                    columnValueMap.insert({mRelationMapping.backwardMapping(SqlEntityConfigurer<ClassType>::tableName(), f->name()), f->fetchFromInstance(classInstance).toString()});
-                }
+            std::unique_ptr<SqlStatement> statement(driver->createStatement(sqlStatement));
 
+            typename FieldType::const_iterator iter = fieldInstanceContainer.begin();
+            while (iter != fieldInstanceContainer.end()) {
                 FieldItemType fieldInstance = *iter;
                 FieldItemPureType* pFieldInstance = Utility::pointerizeInstance(&fieldInstance);
-                for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList()) {
-                    columnValueMap.insert({mRelationMapping.backwardMapping(SqlEntityConfigurer<FieldItemPureType>::tableName(), f->name()), f->fetchFromInstance(pFieldInstance).toString()});
-                }
-
-                const std::string& sqlStatement = SqlGenerator::insert(mRelationMapping.intersectionTableName(), columnValueMap);
 
                 SALSABIL_LOG_INFO(sqlStatement);
-                driver->execute(sqlStatement);
+                statement->reset();
+                int position = 1;
+                for (const auto& f : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                    f->writeToStatement(statement.get(), classInstance, position++);
+                for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList())
+                    f->writeToStatement(statement.get(), pFieldInstance, position++);
+                statement->execute();
 
                 ++iter;
             }
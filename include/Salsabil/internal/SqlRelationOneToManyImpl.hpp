@@ -29,6 +29,10 @@
 #include "SqlGenerator.hpp"
 #include "AccessWrapper.hpp"
 
+#include <algorithm>
+#include <map>
+#include <memory>
+
 namespace Salsabil {
     class SqlDriver;
 
@@ -52,32 +56,43 @@ namespace Salsabil {
         virtual void writeToDriver(SqlDriver* driver, const ClassType* classInstance) override {
             if (mCascade & CascadeType::Persist) {
 
-                std::map<std::string, std::string> columnNameValueMap;
-                auto primaryFieldList = SqlEntityConfigurer<ClassType>::primaryFieldList();
-                for (std::size_t idx = 0; idx < primaryFieldList.size(); ++idx) {
-                    columnNameValueMap.insert({mColumnNameMap.at(primaryFieldList.at(idx)->name()), primaryFieldList.at(idx)->fetchFromInstance(classInstance).toString()});
+                std::vector<std::string> columnList;
+                for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                    columnList.push_back(mColumnNameMap.at(field->name()));
+
+                std::vector<SqlField<FieldItemPureType>*> itemFieldCandidateList(SqlEntityConfigurer<FieldItemPureType>::primaryFieldList());
+                itemFieldCandidateList.insert(itemFieldCandidateList.end(), SqlEntityConfigurer<FieldItemPureType>::fieldList().begin(), SqlEntityConfigurer<FieldItemPureType>::fieldList().end());
+
+                // the foreign key columns take precedence over the item's own fields with the same name.
+                std::vector<SqlField<FieldItemPureType>*> itemFieldList;
+                for (const auto& field : itemFieldCandidateList) {
+                    if (std::find(columnList.begin(), columnList.end(), field->name()) == columnList.end()) {
+                        columnList.push_back(field->name());
+                        itemFieldList.push_back(field);
+                    }
                 }
 
+                const std::string& sqlStatement = SqlGenerator::preparedInsert(SqlRelation<ClassType>::tableName(), columnList);
+
                 FieldType fieldInstanceContainer;
                 mAccessWrapper->get(classInstance, &fieldInstanceContainer);
 
-                for (auto fieldInstanceItem : fieldInstanceContainer) {
-                    std::map<std::string, std::string> whereConditionMap(columnNameValueMap);
+                if (fieldInstanceContainer.empty())
+                    return;
+
+                std::unique_ptr<SqlStatement> statement(driver->createStatement(sqlStatement));
 
+                for (auto fieldInstanceItem : fieldInstanceContainer) {
                     FieldItemPureType* pFieldInstanceItem = Utility::pointerizeInstance(&fieldInstanceItem);
-                    for (const auto field : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList()) {
-                        //                    whereConditionMap.insert({field->name(), field->fetchFromInstance(pFieldInstanceItem).toString()});
-                        whereConditionMap.insert({field->name(), field->fetchFromInstance(pFieldInstanceItem).toString()});
-                    }
-                    for (const auto field : SqlEntityConfigurer<FieldItemPureType>::fieldList())
-                        whereConditionMap.insert({field->name(), field->fetchFromInstance(pFieldInstanceItem).toString()});
 
-                    //                std::string sqlStatement = SqlGenerator::update(SqlRelation<ClassType>::tableName(), columnNameValueMap, whereConditionMap);
-                    //                    for (auto p : columnNameValueMap)
-                    //                        std::cout << "[" << p.first << ", " << p.second << "]" << "\t";
-                    std::string sqlStatement = SqlGenerator::insert(SqlRelation<ClassType>::tableName(), whereConditionMap);
                     SALSABIL_LOG_INFO(sqlStatement);
-                    driver->execute(sqlStatement);
+                    statement->reset();
+                    int position = 1;
+                    for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->writeToStatement(statement.get(), classInstance, position++);
+                    for (const auto& field : itemFieldList)
+                        field->writeToStatement(statement.get(), pFieldInstanceItem, position++);
+                    statement->execute();
                 }
             }
         }
@@ -91,32 +106,105 @@ namespace Salsabil {
         //        }
 
         virtual void fetch(SqlDriver* driver, ClassType* classInstance) override {
-            std::map<std::string, std::string> columnNameValueMap;
-            auto primaryFieldList = SqlEntityConfigurer<ClassType>::primaryFieldList();
-            for (std::size_t idx = 0; idx < primaryFieldList.size(); ++idx) {
-                columnNameValueMap.insert({mColumnNameMap.at(primaryFieldList.at(idx)->name()), primaryFieldList.at(idx)->fetchFromInstance(classInstance).toString()});
-            }
-            std::string sqlStatement = SqlGenerator::fetchById(SqlRelation<ClassType>::tableName(), columnNameValueMap);
+            std::vector<std::string> columnList;
+            for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                columnList.push_back(mColumnNameMap.at(field->name()));
+
+            std::string sqlStatement = SqlGenerator::preparedFetchById(SqlRelation<ClassType>::tableName(), columnList);
 
             SALSABIL_LOG_INFO(sqlStatement);
-            driver->execute(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, SqlRelation<ClassType>::tableNameList()));
+            int position = 1;
+            for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                field->writeToStatement(statement.get(), classInstance, position++);
+            statement->execute();
 
             FieldType fieldInstanceContainer;
 
-            while (driver->nextRow()) {
+            while (statement->nextRow()) {
                 FieldItemType fieldInstance;
                 FieldItemPureType* pFieldInstance = Utility::initializeInstance(&fieldInstance);
                 for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList())
-                    f->readFromDriver(pFieldInstance, f->column());
+                    f->readFromStatement(statement.get(), pFieldInstance, f->column());
                 for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::fieldList())
-                    f->readFromDriver(pFieldInstance, f->column());
+                    f->readFromStatement(statement.get(), pFieldInstance, f->column());
                 for (const auto& r : SqlEntityConfigurer<FieldItemPureType>::transientFieldList())
                     r->fetch(driver, pFieldInstance);
 
                 fieldInstanceContainer.push_back(pFieldInstance);
             }
 
-            mAccessWrapper->set(classInstance, &fieldInstanceContainer);
+            mAccessWrapper->move(classInstance, &fieldInstanceContainer);
+        }
+
+        virtual void readAllFromDriver(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) override {
+            fetchAll(driver, classInstanceList);
+        }
+
+        virtual void fetchAll(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) override {
+            std::vector<std::string> columnList;
+            for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                columnList.push_back(mColumnNameMap.at(field->name()));
+
+            // the foreign key columns are selected once more at the end of each row, to tell which instance the row belongs to.
+            const std::string& keyColumns = Utility::join(columnList.begin(), columnList.end(), ", ");
+
+            std::map<std::string, FieldType> fieldInstanceContainerMap;
+            std::vector<FieldItemPureType*> fieldInstanceList;
+
+            const std::size_t batchSize = SqlRelation<ClassType>::batchSize(driver, columnList.size());
+            for (std::size_t first = 0; first < classInstanceList.size(); first += batchSize) {
+                const std::size_t count = std::min(batchSize, classInstanceList.size() - first);
+
+                std::string sqlStatement = "SELECT *, " + keyColumns + " FROM " + SqlRelation<ClassType>::tableName() + " WHERE " + SqlGenerator::preparedIn(columnList, count);
+
+                SALSABIL_LOG_INFO(sqlStatement);
+                std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, SqlRelation<ClassType>::tableNameList()));
+                int position = 1;
+                for (std::size_t idx = first; idx < first + count; ++idx) {
+                    for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->writeToStatement(statement.get(), classInstanceList[idx], position++);
+                }
+                statement->execute();
+
+                const int keyColumn = statement->columnCount() - columnList.size();
+                ClassType keyInstance;
+
+                while (statement->nextRow()) {
+                    FieldItemType fieldInstance;
+                    FieldItemPureType* pFieldInstance = Utility::initializeInstance(&fieldInstance);
+                    for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::primaryFieldList())
+                        f->readFromStatement(statement.get(), pFieldInstance, f->column());
+                    for (const auto& f : SqlEntityConfigurer<FieldItemPureType>::fieldList())
+                        f->readFromStatement(statement.get(), pFieldInstance, f->column());
+
+                    int column = keyColumn;
+                    for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->readFromStatement(statement.get(), &keyInstance, column++);
+
+                    fieldInstanceContainerMap[SqlEntityConfigurer<ClassType>::primaryKey(&keyInstance)].push_back(pFieldInstance);
+                    fieldInstanceList.push_back(pFieldInstance);
+                }
+            }
+
+            for (const auto& r : SqlEntityConfigurer<FieldItemPureType>::transientFieldList())
+                r->fetchAll(driver, fieldInstanceList);
+
+            // each container is moved into the last instance sharing its key, and copied into the ones before it.
+            std::vector<std::string> keyList;
+            std::map<std::string, std::size_t> keySharingCountMap;
+            for (auto classInstance : classInstanceList) {
+                keyList.push_back(SqlEntityConfigurer<ClassType>::primaryKey(classInstance));
+                ++keySharingCountMap[keyList.back()];
+            }
+
+            for (std::size_t idx = 0; idx < classInstanceList.size(); ++idx) {
+                FieldType& fieldInstanceContainer = fieldInstanceContainerMap[keyList[idx]];
+                if (--keySharingCountMap[keyList[idx]] == 0)
+                    mAccessWrapper->move(classInstanceList[idx], &fieldInstanceContainer);
+                else
+                    mAccessWrapper->set(classInstanceList[idx], &fieldInstanceContainer);
+            }
         }
 
         virtual void persist(const ClassType* classInstance) override {
@@ -130,6 +218,10 @@ namespace Salsabil {
             }
         }
 
+        virtual bool cascadesUpdate() const override {
+            return (mCascade & CascadeType::Update) != 0;
+        }
+
         virtual void update(const ClassType* classInstance) override {
             if (mCascade & CascadeType::Update) {
                 FieldType fieldInstanceContainer;
@@ -30,6 +30,10 @@
 #include "SqlGenerator.hpp"
 #include "AccessWrapper.hpp"
 #include "SqlRepository.hpp"
+#include "Declarations.hpp"
+
+#include <map>
+#include <memory>
 
 namespace Salsabil {
     class SqlDriver;
@@ -39,12 +43,14 @@ namespace Salsabil {
         using FieldPureType = typename Utility::Traits<FieldType>::UnqualifiedType;
         std::map<std::string, std::string> mColumnNameMap;
         std::unique_ptr<AccessWrapper<ClassType, FieldType>> mAccessWrapper;
+        FetchType mFetchType;
 
     public:
 
-        SqlRelationOneToOnePersistentImpl(const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, RelationType type, AccessWrapper<ClassType, FieldType>* accessWrapper) :
+        SqlRelationOneToOnePersistentImpl(const std::string& targetTableName, const std::map<std::string, std::string>& columnNameMap, RelationType type, AccessWrapper<ClassType, FieldType>* accessWrapper, FetchType fetchType = FetchType::Select) :
         SqlRelation<ClassType>(targetTableName, type),
-        mAccessWrapper(accessWrapper) {
+        mAccessWrapper(accessWrapper),
+        mFetchType(fetchType) {
             for (auto columnNamePair : columnNameMap) {
                 mColumnNameMap.insert({columnNamePair.second, columnNamePair.first});
             }
@@ -58,25 +64,143 @@ namespace Salsabil {
 
             FieldPureType* pFieldInstance = Utility::pointerizeInstance(&fieldInstance);
 
-            std::map<std::string, std::string> columnNameValueMap;
-            auto primaryFieldList = SqlEntityConfigurer<FieldPureType>::primaryFieldList();
-            for (std::size_t idx = 0; idx < primaryFieldList.size(); ++idx) {
-                columnNameValueMap.insert({primaryFieldList.at(idx)->name(), primaryFieldList.at(idx)->fetchFromInstance(pFieldInstance).toString()});
-            }
-            std::string sqlStatement = SqlGenerator::fetchById(SqlRelation<ClassType>::tableName(), columnNameValueMap);
+            std::vector<std::string> columnList;
+            for (const auto& field : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                columnList.push_back(field->name());
+
+            std::string sqlStatement = SqlGenerator::preparedFetchById(SqlRelation<ClassType>::tableName(), columnList);
 
             SALSABIL_LOG_INFO(sqlStatement);
-            driver->execute(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, SqlRelation<ClassType>::tableNameList()));
+            int position = 1;
+            for (const auto& field : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                field->writeToStatement(statement.get(), pFieldInstance, position++);
+            statement->execute();
 
-            if (!driver->nextRow())
+            if (!statement->nextRow())
                 throw Exception("SqlRelationOneToOnePersistentImpl, readFromDriver, no rows to fetch");
 
             for (const auto& f : SqlEntityConfigurer<FieldPureType>::fieldList())
-                f->readFromDriver(pFieldInstance, f->column());
+                f->readFromStatement(statement.get(), pFieldInstance, f->column());
+            for (const auto& r : SqlEntityConfigurer<FieldPureType>::transientFieldList())
+                r->readFromDriver(driver, pFieldInstance);
+
+            mAccessWrapper->move(classInstance, &fieldInstance);
+        }
+
+        virtual void readAllFromDriver(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) override {
+            SALSABIL_LOG_DEBUG("SqlRelationOneToOnePersistentImpl, readAllFromDriver");
+
+            std::vector<FieldType> fieldInstanceList(classInstanceList.size());
+
+            // instances referring to the same row are looked up by a single key.
+            std::map<std::string, std::vector<FieldPureType*>> pFieldInstanceMap;
+            std::vector<FieldPureType*> keyInstanceList;
+
+            for (std::size_t idx = 0; idx < classInstanceList.size(); ++idx) {
+                mAccessWrapper->get(classInstanceList[idx], &fieldInstanceList[idx]);
+                FieldPureType* pFieldInstance = Utility::pointerizeInstance(&fieldInstanceList[idx]);
+
+                std::vector<FieldPureType*>& sharingInstanceList = pFieldInstanceMap[SqlEntityConfigurer<FieldPureType>::primaryKey(pFieldInstance)];
+                if (sharingInstanceList.empty())
+                    keyInstanceList.push_back(pFieldInstance);
+                sharingInstanceList.push_back(pFieldInstance);
+            }
+
+            std::vector<std::string> columnList;
+            for (const auto& field : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                columnList.push_back(field->name());
+
+            std::size_t fetchedKeyCount = 0;
+
+            const std::size_t batchSize = SqlRelation<ClassType>::batchSize(driver, columnList.size());
+            for (std::size_t first = 0; first < keyInstanceList.size(); first += batchSize) {
+                const std::size_t count = std::min(batchSize, keyInstanceList.size() - first);
+
+                std::string sqlStatement = "SELECT * FROM " + SqlRelation<ClassType>::tableName() + " WHERE " + SqlGenerator::preparedIn(columnList, count);
+
+                SALSABIL_LOG_INFO(sqlStatement);
+                std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, SqlRelation<ClassType>::tableNameList()));
+                int position = 1;
+                for (std::size_t idx = first; idx < first + count; ++idx) {
+                    for (const auto& field : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                        field->writeToStatement(statement.get(), keyInstanceList[idx], position++);
+                }
+                statement->execute();
+
+                FieldPureType keyInstance;
+
+                while (statement->nextRow()) {
+                    for (const auto& f : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                        f->readFromStatement(statement.get(), &keyInstance, f->column());
+
+                    for (auto pFieldInstance : pFieldInstanceMap[SqlEntityConfigurer<FieldPureType>::primaryKey(&keyInstance)]) {
+                        for (const auto& f : SqlEntityConfigurer<FieldPureType>::fieldList())
+                            f->readFromStatement(statement.get(), pFieldInstance, f->column());
+                    }
+                    ++fetchedKeyCount;
+                }
+            }
+
+            if (fetchedKeyCount != keyInstanceList.size())
+                throw Exception("SqlRelationOneToOnePersistentImpl, readAllFromDriver, no rows to fetch");
+
+            // the relations of instances sharing a row are read one by one, so that they don't share related instances either.
+            for (const auto& r : SqlEntityConfigurer<FieldPureType>::transientFieldList()) {
+                r->readAllFromDriver(driver, keyInstanceList);
+                for (const auto& keySharingInstanceListPair : pFieldInstanceMap) {
+                    for (std::size_t idx = 1; idx < keySharingInstanceListPair.second.size(); ++idx)
+                        r->readFromDriver(driver, keySharingInstanceListPair.second[idx]);
+                }
+            }
+
+            for (std::size_t idx = 0; idx < classInstanceList.size(); ++idx)
+                mAccessWrapper->move(classInstanceList[idx], &fieldInstanceList[idx]);
+        }
+
+        virtual bool isJoinFetched() const override {
+            return mFetchType == FetchType::Join;
+        }
+
+        virtual std::vector<std::string> joinColumnList(const std::string& alias) const override {
+            std::vector<std::string> columnList;
+            for (const auto& f : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                columnList.push_back(alias + "." + f->name() + " AS " + alias + "_" + f->name());
+            for (const auto& f : SqlEntityConfigurer<FieldPureType>::fieldList())
+                columnList.push_back(alias + "." + f->name() + " AS " + alias + "_" + f->name());
+            return columnList;
+        }
+
+        virtual std::size_t joinColumnCount() const override {
+            return SqlEntityConfigurer<FieldPureType>::primaryFieldList().size() + SqlEntityConfigurer<FieldPureType>::fieldList().size();
+        }
+
+        virtual std::string joinClause(const std::string& alias) const override {
+            std::vector<std::string> onConditionList;
+            for (const auto& f : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                onConditionList.push_back(SqlEntityConfigurer<ClassType>::tableName() + "." + mColumnNameMap.at(f->name()) + " = " + alias + "." + f->name());
+            return "LEFT JOIN " + SqlRelation<ClassType>::tableName() + " AS " + alias + " ON " + Utility::join(onConditionList.begin(), onConditionList.end(), " AND ");
+        }
+
+        virtual void readFromJoin(SqlDriver* driver, SqlStatement* statement, int firstColumn, ClassType* classInstance) override {
+            SALSABIL_LOG_DEBUG("SqlRelationOneToOnePersistentImpl, readFromJoin at column: " + std::to_string(firstColumn));
+
+            // the joined columns are NULL if no row of the target table is referred to.
+            if (statement->isNull(firstColumn))
+                throw Exception("SqlRelationOneToOnePersistentImpl, readFromJoin, no rows to fetch");
+
+            FieldType fieldInstance;
+            mAccessWrapper->get(classInstance, &fieldInstance);
+
+            FieldPureType* pFieldInstance = Utility::pointerizeInstance(&fieldInstance);
+
+            int column = firstColumn + SqlEntityConfigurer<FieldPureType>::primaryFieldList().size();
+            for (const auto& f : SqlEntityConfigurer<FieldPureType>::fieldList())
+                f->readFromStatement(statement, pFieldInstance, column++);
             for (const auto& r : SqlEntityConfigurer<FieldPureType>::transientFieldList())
                 r->readFromDriver(driver, pFieldInstance);
 
-            mAccessWrapper->set(classInstance, &fieldInstance);
+            mAccessWrapper->move(classInstance, &fieldInstance);
         }
 
         virtual void writeToDriver(SqlDriver*, const ClassType*) {
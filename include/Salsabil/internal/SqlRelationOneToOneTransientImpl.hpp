@@ -31,6 +31,9 @@
 #include "Logging.hpp"
 #include "Declarations.hpp"
 
+#include <map>
+#include <memory>
+
 namespace Salsabil {
     class SqlDriver;
 
@@ -59,30 +62,100 @@ namespace Salsabil {
         }
 
         virtual void fetch(SqlDriver* driver, ClassType* classInstance) override {
-            std::map<std::string, std::string> columnNameValueMap;
-            auto primaryFieldList = SqlEntityConfigurer<ClassType>::primaryFieldList();
-            for (std::size_t idx = 0; idx < primaryFieldList.size(); ++idx) {
-                columnNameValueMap.insert({mColumnNameMap.at(primaryFieldList.at(idx)->name()), primaryFieldList.at(idx)->fetchFromInstance(classInstance).toString()});
-            }
-            std::string sqlStatement = SqlGenerator::fetchById(SqlRelation<ClassType>::tableName(), columnNameValueMap);
+            std::vector<std::string> columnList;
+            for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                columnList.push_back(mColumnNameMap.at(field->name()));
+
+            std::string sqlStatement = SqlGenerator::preparedFetchById(SqlRelation<ClassType>::tableName(), columnList);
 
             SALSABIL_LOG_INFO(sqlStatement);
-            driver->execute(sqlStatement);
+            std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, SqlRelation<ClassType>::tableNameList()));
+            int position = 1;
+            for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                field->writeToStatement(statement.get(), classInstance, position++);
+            statement->execute();
 
-            if (!driver->nextRow())
+            if (!statement->nextRow())
                 throw Exception("no rows found");
 
             FieldType fieldInstance;
             FieldPureType* pfieldInstance = Utility::initializeInstance(&fieldInstance);
 
             for (const auto& f : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
-                f->readFromDriver(pfieldInstance, f->column());
+                f->readFromStatement(statement.get(), pfieldInstance, f->column());
             for (const auto& f : SqlEntityConfigurer<FieldPureType>::fieldList())
-                f->readFromDriver(pfieldInstance, f->column());
+                f->readFromStatement(statement.get(), pfieldInstance, f->column());
             for (const auto& r : SqlEntityConfigurer<FieldPureType>::transientFieldList())
                 r->fetch(driver, pfieldInstance);
 
-            mAccessWrapper->set(classInstance, &fieldInstance);
+            mAccessWrapper->move(classInstance, &fieldInstance);
+        }
+
+        virtual void readAllFromDriver(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) override {
+            fetchAll(driver, classInstanceList);
+        }
+
+        virtual void fetchAll(SqlDriver* driver, const std::vector<ClassType*>& classInstanceList) override {
+            std::vector<std::string> columnList;
+            for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                columnList.push_back(mColumnNameMap.at(field->name()));
+
+            // the foreign key columns are selected once more at the end of each row, to tell which instance the row belongs to.
+            const std::string& keyColumns = Utility::join(columnList.begin(), columnList.end(), ", ");
+
+            std::map<std::string, FieldType> fieldInstanceMap;
+            std::vector<FieldPureType*> pFieldInstanceList;
+
+            const std::size_t batchSize = SqlRelation<ClassType>::batchSize(driver, columnList.size());
+            for (std::size_t first = 0; first < classInstanceList.size(); first += batchSize) {
+                const std::size_t count = std::min(batchSize, classInstanceList.size() - first);
+
+                std::string sqlStatement = "SELECT *, " + keyColumns + " FROM " + SqlRelation<ClassType>::tableName() + " WHERE " + SqlGenerator::preparedIn(columnList, count);
+
+                SALSABIL_LOG_INFO(sqlStatement);
+                std::unique_ptr<SqlStatement> statement(SqlEntityConfigurer<ClassType>::createQueryStatement(driver, sqlStatement, SqlRelation<ClassType>::tableNameList()));
+                int position = 1;
+                for (std::size_t idx = first; idx < first + count; ++idx) {
+                    for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->writeToStatement(statement.get(), classInstanceList[idx], position++);
+                }
+                statement->execute();
+
+                const int keyColumn = statement->columnCount() - columnList.size();
+                ClassType keyInstance;
+
+                while (statement->nextRow()) {
+                    int column = keyColumn;
+                    for (const auto& field : SqlEntityConfigurer<ClassType>::primaryFieldList())
+                        field->readFromStatement(statement.get(), &keyInstance, column++);
+
+                    // like fetch(), only the first row referring to an instance is taken.
+                    const std::string& key = SqlEntityConfigurer<ClassType>::primaryKey(&keyInstance);
+                    if (fieldInstanceMap.count(key))
+                        continue;
+
+                    FieldType& fieldInstance = fieldInstanceMap[key];
+                    FieldPureType* pfieldInstance = Utility::initializeInstance(&fieldInstance);
+
+                    for (const auto& f : SqlEntityConfigurer<FieldPureType>::primaryFieldList())
+                        f->readFromStatement(statement.get(), pfieldInstance, f->column());
+                    for (const auto& f : SqlEntityConfigurer<FieldPureType>::fieldList())
+                        f->readFromStatement(statement.get(), pfieldInstance, f->column());
+
+                    pFieldInstanceList.push_back(pfieldInstance);
+                }
+            }
+
+            for (auto classInstance : classInstanceList) {
+                if (!fieldInstanceMap.count(SqlEntityConfigurer<ClassType>::primaryKey(classInstance)))
+                    throw Exception("no rows found");
+            }
+
+            for (const auto& r : SqlEntityConfigurer<FieldPureType>::transientFieldList())
+                r->fetchAll(driver, pFieldInstanceList);
+
+            for (auto classInstance : classInstanceList)
+                mAccessWrapper->set(classInstance, &fieldInstanceMap[SqlEntityConfigurer<ClassType>::primaryKey(classInstance)]);
         }
 
         virtual void persist(const ClassType* classInstance) override {
@@ -90,6 +163,10 @@ namespace Salsabil {
                 SqlRepository<FieldPureType>::persist(pointerizedFieldInstance(classInstance));
         }
 
+        virtual bool cascadesUpdate() const override {
+            return (mCascade & CascadeType::Update) != 0;
+        }
+
         virtual void update(const ClassType* classInstance) override {
             if (mCascade & CascadeType::Update)
                 SqlRepository<FieldPureType>::update(pointerizedFieldInstance(classInstance));
@@ -23,6 +23,7 @@
 #define SALSABIL_SQLRELATIONALFIELD_HPP
 
 #include <string>
+#include <vector>
 #include <map>
 
 #include "SqlValue.hpp"
@@ -47,11 +48,32 @@ namespace Salsabil {
         virtual ~SqlRelationalField() {
         }
 
-        virtual void injectInto(ClassType* instance) = 0;
+        virtual void injectInto(SqlStatement* statement, ClassType* instance) = 0;
+
+        /* Injects the entity whose primary key is read from the columns of <i>statement</i> from <i>firstColumn</i> on, in the order of #columnNameList(). */
+        virtual void injectInto(SqlStatement* statement, ClassType* instance, int firstColumn) = 0;
 
         virtual std::map<std::string, std::string> parseFrom(const ClassType* instance) = 0;
 
-        std::map<std::string, std::string> columnNameMap() const {
+        /* Frees the entity injected into <i>instance</i> by injectInto(), if it is held by a pointer, without the relations read into it. */
+        virtual void release(ClassType* instance) = 0;
+
+        /* Binds the primary key of the entity related to <i>instance</i> to <i>statement</i> starting from placeholder <i>position</i>, in the order of #columnNameList(). */
+        virtual void writeToStatement(SqlStatement* statement, const ClassType* instance, int position) = 0;
+
+        /* Returns the names of the columns holding the primary key of the related entity. */
+        std::vector<std::string> columnNameList() const {
+            std::vector<std::string> nameList;
+            for (const auto& columnNamePair : mColumnNameMap)
+                nameList.push_back(columnNamePair.second);
+            return nameList;
+        }
+
+        std::size_t columnCount() const {
+            return mColumnNameMap.size();
+        }
+
+        const std::map<std::string, std::string>& columnNameMap() const {
             return mColumnNameMap;
         }
 
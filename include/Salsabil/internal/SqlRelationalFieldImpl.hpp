@@ -29,9 +29,10 @@
 #include "Logging.hpp"
 
 #include <memory>
+#include <type_traits>
 
 namespace Salsabil {
-    class SqlDriver;
+    class SqlStatement;
 
     template<typename ClassType, typename FieldType>
     class SqlRelationalFieldImpl : public SqlRelationalField<ClassType> {
@@ -45,16 +46,43 @@ namespace Salsabil {
         mAccessWrapper(accessWrapper) {
         }
 
-        virtual void injectInto(ClassType* instance) {
+        virtual void injectInto(SqlStatement* statement, ClassType* instance) {
             SALSABIL_LOG_DEBUG("SqlRelationalFieldImpl, inject");
             FieldType t;
             auto pt = Utility::initializeInstance(&t);
             auto primaryFieldList = SqlEntityConfigurer<FieldPureType>::primaryFieldList();
             for (std::size_t idx = 0; idx < primaryFieldList.size(); ++idx) {
-                primaryFieldList[idx]->readFromDriver(pt, SqlRelationalField<ClassType>::columnNameIndexMap().at(primaryFieldList[idx]->name()));
+                primaryFieldList[idx]->readFromStatement(statement, pt, SqlRelationalField<ClassType>::columnNameIndexMap().at(primaryFieldList[idx]->name()));
             }
 
-            mAccessWrapper->set(instance, &t);
+            mAccessWrapper->move(instance, &t);
+        }
+
+        virtual void injectInto(SqlStatement* statement, ClassType* instance, int firstColumn) {
+            FieldType t;
+            auto pt = Utility::initializeInstance(&t);
+            int column = firstColumn;
+            for (const auto& columnNamePair : SqlRelationalField<ClassType>::columnNameMap()) {
+                for (const auto& field : SqlEntityConfigurer<FieldPureType>::primaryFieldList()) {
+                    if (field->name() == columnNamePair.first) {
+                        field->readFromStatement(statement, pt, column);
+                        break;
+                    }
+                }
+                ++column;
+            }
+
+            mAccessWrapper->move(instance, &t);
+        }
+
+        virtual void release(ClassType* instance) {
+            if (!std::is_pointer<FieldType>::value)
+                return;
+
+            FieldType t;
+            mAccessWrapper->get(instance, &t);
+            Utility::releaseInstance(&t);
+            mAccessWrapper->move(instance, &t);
         }
 
         virtual std::map<std::string, std::string> parseFrom(const ClassType* instance) {
@@ -68,6 +96,26 @@ namespace Salsabil {
                 columnValueMap.insert({SqlRelationalField<ClassType>::columnNameMap().at(pfList[idx]->name()), pfList[idx]->fetchFromInstance(pt).toString()});
             return columnValueMap;
         }
+
+        virtual void writeToStatement(SqlStatement* statement, const ClassType* instance, int position) {
+            SALSABIL_LOG_DEBUG("SqlRelationalFieldImpl, writeToStatement at position: " + std::to_string(position));
+            FieldType t;
+            mAccessWrapper->get(instance, &t);
+            auto pt = Utility::pointerizeInstance(&t);
+            for (const auto& columnNamePair : SqlRelationalField<ClassType>::columnNameMap()) {
+                if (pt == nullptr) {
+                    statement->bindNull(position++);
+                    continue;
+                }
+                for (const auto& field : SqlEntityConfigurer<FieldPureType>::primaryFieldList()) {
+                    if (field->name() == columnNamePair.first) {
+                        field->writeToStatement(statement, pt, position);
+                        break;
+                    }
+                }
+                ++position;
+            }
+        }
     };
 }
 #endif // SALSABIL_SQLRELATIONALFIELDIMPL_HPP
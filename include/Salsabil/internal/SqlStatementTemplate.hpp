@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLSTATEMENTTEMPLATE_HPP
+#define SALSABIL_SQLSTATEMENTTEMPLATE_HPP
+
+#include <string>
+#include <vector>
+
+#include "SqlField.hpp"
+#include "SqlRelationalField.hpp"
+
+namespace Salsabil {
+    class SqlStatement;
+
+    /* 
+     * SqlStatementTemplate holds the text of a statement with numbered placeholders along with 
+     * the fields whose values are bound to these placeholders, in order. 
+     */
+    template<typename ClassType>
+    class SqlStatementTemplate {
+        struct Parameter {
+            SqlField<ClassType>* field;
+            SqlRelationalField<ClassType>* relationalField;
+        };
+
+        std::string mText;
+        std::vector<Parameter> mParameterList;
+        std::size_t mPlaceholderCount;
+
+    public:
+
+        SqlStatementTemplate() : mPlaceholderCount(0) {
+        }
+
+        explicit SqlStatementTemplate(const std::string& text) : mText(text), mPlaceholderCount(0) {
+        }
+
+        const std::string& text() const {
+            return mText;
+        }
+
+        bool isEmpty() const {
+            return mText.empty();
+        }
+
+        /* Returns the number of placeholders the parameters of a single instance are bound to. */
+        std::size_t placeholderCount() const {
+            return mPlaceholderCount;
+        }
+
+        void addParameter(SqlField<ClassType>* field) {
+            mParameterList.push_back({field, nullptr});
+            ++mPlaceholderCount;
+        }
+
+        void addParameter(SqlRelationalField<ClassType>* relationalField) {
+            mParameterList.push_back({nullptr, relationalField});
+            mPlaceholderCount += relationalField->columnCount();
+        }
+
+        void addParameters(const std::vector<SqlField<ClassType>*>& fieldList) {
+            for (auto field : fieldList)
+                addParameter(field);
+        }
+
+        void addParameters(const std::vector<SqlRelationalField<ClassType>*>& relationalFieldList) {
+            for (auto relationalField : relationalFieldList)
+                addParameter(relationalField);
+        }
+
+        /* 
+         * Binds the values of the parameters from <i>instance</i> to <i>statement</i> starting from placeholder <i>position</i>, 
+         * and returns the position following the last bound placeholder. 
+         */
+        int bind(SqlStatement* statement, const ClassType* instance, int position = 1) const {
+            for (const auto& parameter : mParameterList) {
+                if (parameter.field) {
+                    parameter.field->writeToStatement(statement, instance, position++);
+                } else {
+                    parameter.relationalField->writeToStatement(statement, instance, position);
+                    position += parameter.relationalField->columnCount();
+                }
+            }
+            return position;
+        }
+    };
+}
+
+#endif // SALSABIL_SQLSTATEMENTTEMPLATE_HPP
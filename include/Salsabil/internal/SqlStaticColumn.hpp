@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLSTATICCOLUMN_HPP
+#define SALSABIL_SQLSTATICCOLUMN_HPP
+
+#include "SqlStatement.hpp"
+#include "TypeHelper.hpp"
+#include "TypeResolver.hpp"
+
+#include <string>
+#include <tuple>
+
+namespace Salsabil {
+
+    /* 
+     * SqlStaticAttributeColumn maps a column to an attribute. Unlike SqlFieldImpl, it is neither virtual nor allocated, 
+     * and it reads and binds the attribute in place, without a temporary copy of its value.
+     */
+    template<class ClassType, typename FieldType>
+    class SqlStaticAttributeColumn {
+        std::string mName;
+        FieldType ClassType::* mAttributePtr;
+
+    public:
+
+        SqlStaticAttributeColumn(const std::string& name, FieldType ClassType::* attribute) : mName(name), mAttributePtr(attribute) {
+        }
+
+        const std::string& name() const {
+            return mName;
+        }
+
+        void read(const SqlStatement* statement, ClassType* instance, int column) const {
+            Utility::statementToVariable(statement, column, &(instance->*mAttributePtr));
+        }
+
+        void write(SqlStatement* statement, const ClassType* instance, int position) const {
+            // variableToStatement only reads the variable it is given.
+            Utility::variableToStatement(statement, position, const_cast<FieldType*> (&(instance->*mAttributePtr)));
+        }
+    };
+
+    /* 
+     * SqlStaticMethodColumn maps a column to a getter and a setter. The value read from a statement is moved into 
+     * the setter if it takes it by value or by rvalue reference.
+     */
+    template<class ClassType, typename GetMethodType, typename SetMethodType>
+    class SqlStaticMethodColumn {
+        using FieldType = typename Utility::Traits<GetMethodType>::ReturnType;
+        using SetterArgumentType = typename Utility::Traits<SetMethodType>::template argument<1>::type;
+
+        std::string mName;
+        GetMethodType mGetterPtr;
+        SetMethodType mSetterPtr;
+
+    public:
+
+        SqlStaticMethodColumn(const std::string& name, GetMethodType getter, SetMethodType setter) : mName(name), mGetterPtr(getter), mSetterPtr(setter) {
+        }
+
+        const std::string& name() const {
+            return mName;
+        }
+
+        void read(const SqlStatement* statement, ClassType* instance, int column) const {
+            FieldType t;
+            Utility::statementToVariable(statement, column, &t);
+            (instance->*mSetterPtr)(static_cast<SetterArgumentType&&> (t));
+        }
+
+        void write(SqlStatement* statement, const ClassType* instance, int position) const {
+            FieldType t = (instance->*mGetterPtr)();
+            Utility::variableToStatement(statement, position, &t);
+        }
+    };
+
+    namespace Utility {
+
+        // calls visitor with each element of a tuple along with its index, in order, unrolled at compile time.
+        template<std::size_t Index, std::size_t Count>
+        struct TupleVisitor {
+
+            template<typename Tuple, typename Visitor>
+            static void visit(const Tuple& tuple, Visitor& visitor) {
+                visitor(std::get<Index>(tuple), static_cast<int> (Index));
+                TupleVisitor<Index + 1, Count>::visit(tuple, visitor);
+            }
+        };
+
+        template<std::size_t Count>
+        struct TupleVisitor<Count, Count> {
+
+            template<typename Tuple, typename Visitor>
+            static void visit(const Tuple&, Visitor&) {
+            }
+        };
+    }
+}
+
+#endif // SALSABIL_SQLSTATICCOLUMN_HPP
@@ -22,30 +22,254 @@
 #ifndef SALSABIL_SQLVALUE_HPP
 #define SALSABIL_SQLVALUE_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
 #include <string>
+#include <utility>
+#include <vector>
 #include "StringHelper.hpp"
+#include "SqlStatement.hpp"
+#include "Exception.hpp"
 
 namespace Salsabil {
 
+    /* 
+     * SqlValue is a tagged union holding a null, a 64-bit integer, a double, a text or a blob natively, so that 
+     * it is bound to statements and compared without being formatted to text. Booleans and the narrower 
+     * integral types are held as integers, as SQLite does.
+     */
     class SqlValue {
-        std::string mValue;
     public:
 
-        SqlValue(int value) : mValue(Utility::toSqlString(value)) {
+        enum class Type {
+            Null, Integer, Real, Text, Blob
+        };
+
+        SqlValue() : mType(Type::Null), mInteger(0) {
+        }
+
+        SqlValue(std::nullptr_t) : SqlValue() {
+        }
+
+        SqlValue(bool value) : mType(Type::Integer), mInteger(value ? 1 : 0) {
+        }
+
+        SqlValue(int value) : mType(Type::Integer), mInteger(value) {
+        }
+
+        SqlValue(unsigned value) : mType(Type::Integer), mInteger(value) {
+        }
+
+        SqlValue(long value) : mType(Type::Integer), mInteger(value) {
+        }
+
+        SqlValue(long long value) : mType(Type::Integer), mInteger(value) {
+        }
+
+        /// @throw Exception if ***value*** is beyond the range of a signed 64-bit integer, in which the value is held.
+        SqlValue(unsigned long value) : SqlValue(static_cast<unsigned long long> (value)) {
+        }
+
+        /// @throw Exception if ***value*** is beyond the range of a signed 64-bit integer, in which the value is held.
+        SqlValue(unsigned long long value) : mType(Type::Integer), mInteger(0) {
+            if (value > static_cast<unsigned long long> (std::numeric_limits<std::int64_t>::max()))
+                throw Exception("Unsigned value " + std::to_string(value) + " is out of the range of a 64-bit integer");
+            mInteger = static_cast<std::int64_t> (value);
+        }
+
+        SqlValue(float value) : mType(Type::Real), mReal(value) {
+        }
+
+        SqlValue(double value) : mType(Type::Real), mReal(value) {
+        }
+
+        // a null pointer is a NULL rather than an empty text.
+        SqlValue(const char* value) : SqlValue() {
+            if (value)
+                construct(Type::Text, std::string(value));
+        }
+
+        SqlValue(std::string value) : mType(Type::Null) {
+            construct(Type::Text, std::move(value));
+        }
+
+        SqlValue(const std::vector<unsigned char>& value) : mType(Type::Null) {
+            construct(Type::Blob, std::string(value.begin(), value.end()));
+        }
+
+        // a blob of size bytes copied from data.
+        static SqlValue blob(const void* data, std::size_t size) {
+            SqlValue value;
+            value.construct(Type::Blob, data ? std::string(static_cast<const char*> (data), size) : std::string());
+            return value;
+        }
+
+        SqlValue(const SqlValue& other) : mType(Type::Null) {
+            copyFrom(other);
+        }
+
+        SqlValue(SqlValue&& other) : mType(Type::Null) {
+            moveFrom(std::move(other));
+        }
+
+        SqlValue& operator=(const SqlValue& other) {
+            if (this != &other) {
+                destroy();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        SqlValue& operator=(SqlValue&& other) {
+            if (this != &other) {
+                destroy();
+                moveFrom(std::move(other));
+            }
+            return *this;
+        }
+
+        ~SqlValue() {
+            destroy();
+        }
+
+        Type type() const {
+            return mType;
+        }
+
+        bool isNull() const {
+            return mType == Type::Null;
         }
 
-        SqlValue(float value) : mValue(Utility::toSqlString(value)) {
+        // the integer value, or the real value truncated.
+        std::int64_t toInt64() const {
+            return mType == Type::Integer ? mInteger : mType == Type::Real ? static_cast<std::int64_t> (mReal) : 0;
         }
 
-        SqlValue(const char* value) : mValue(Utility::toSqlString(value)) {
+        // the real value, or the integer value converted.
+        double toDouble() const {
+            return mType == Type::Real ? mReal : mType == Type::Integer ? static_cast<double> (mInteger) : 0;
         }
 
-        SqlValue(std::string value) : mValue(Utility::toSqlString(value)) {
+        // the bytes of a text or a blob value, i.e., text values aren't quoted.
+        const std::string& text() const {
+            static const std::string empty;
+            return isBytes() ? mBytes : empty;
         }
 
+        // returns the value as a SQL literal, i.e., text values are quoted and blobs are written in hexadecimal.
         std::string toString() const {
-            return mValue;
+            switch (mType) {
+                case Type::Null:
+                    return "NULL";
+                case Type::Integer:
+                    return std::to_string(mInteger);
+                case Type::Real:
+                    return Utility::toString(mReal);
+                case Type::Text:
+                    return Utility::toSqlString(mBytes);
+                case Type::Blob:
+                {
+                    static const char digits[] = "0123456789ABCDEF";
+                    std::string literal = "X'";
+                    for (unsigned char c : mBytes) {
+                        literal += digits[c >> 4];
+                        literal += digits[c & 0x0F];
+                    }
+                    return literal + "'";
+                }
+            }
+            return std::string();
+        }
+
+        // binds the value to the placeholder at position in statement.
+        void bindTo(const SqlStatement* statement, int position) const {
+            switch (mType) {
+                case Type::Null:
+                    statement->bindNull(position);
+                    break;
+                case Type::Integer:
+                    statement->bindInt64(position, mInteger);
+                    break;
+                case Type::Real:
+                    statement->bindDouble(position, mReal);
+                    break;
+                case Type::Text:
+                    statement->bindStdString(position, mBytes);
+                    break;
+                case Type::Blob:
+                    statement->bindBlob(position, mBytes.data(), mBytes.size());
+                    break;
+            }
+        }
+
+        bool operator==(const SqlValue& other) const {
+            if (mType != other.mType)
+                return false;
+            switch (mType) {
+                case Type::Null:
+                    return true;
+                case Type::Integer:
+                    return mInteger == other.mInteger;
+                case Type::Real:
+                    return mReal == other.mReal;
+                default:
+                    return mBytes == other.mBytes;
+            }
+        }
+
+        bool operator!=(const SqlValue& other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        bool isBytes() const {
+            return mType == Type::Text || mType == Type::Blob;
+        }
+
+        // the value must not hold bytes already.
+        void construct(Type type, std::string&& bytes) {
+            new (&mBytes) std::string(std::move(bytes));
+            mType = type;
+        }
+
+        void destroy() {
+            if (isBytes())
+                mBytes.~basic_string();
+            mType = Type::Null;
         }
+
+        void copyFrom(const SqlValue& other) {
+            if (other.isBytes())
+                construct(other.mType, std::string(other.mBytes));
+            else
+                copyScalar(other);
+        }
+
+        void moveFrom(SqlValue&& other) {
+            if (other.isBytes())
+                construct(other.mType, std::move(other.mBytes));
+            else
+                copyScalar(other);
+        }
+
+        void copyScalar(const SqlValue& other) {
+            mType = other.mType;
+            if (mType == Type::Real)
+                mReal = other.mReal;
+            else
+                mInteger = other.mInteger;
+        }
+
+        Type mType;
+
+        union {
+            std::int64_t mInteger;
+            double mReal;
+            std::string mBytes;
+        };
     };
 
 }
@@ -22,11 +22,20 @@
 #ifndef SALSABIL_TYPERESOLVER_HPP
 #define SALSABIL_TYPERESOLVER_HPP
 
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <vector>
 
-#include "SqlDriver.hpp"
+#include "SqlStatement.hpp"
+#include "Exception.hpp"
 #include "internal/Logging.hpp"
 #include "SqlField.hpp"
+#include "Date.hpp"
+#include "Time.hpp"
+#include "DateTime.hpp"
+#include "LocalDateTime.hpp"
+#include "TimeZone.hpp"
 
 
 namespace Salsabil {
@@ -45,6 +54,18 @@ namespace Salsabil {
             return *obj;
         }
 
+        // frees an instance created by initializeInstance(), if it is held by a pointer.
+
+        template<typename T>
+        inline void releaseInstance(T*) {
+        }
+
+        template<typename T>
+        inline void releaseInstance(T** obj) {
+            delete *obj;
+            *obj = nullptr;
+        }
+
         template<typename T>
         inline T* pointerizeInstance(T* obj) {
             return obj;
@@ -79,44 +100,231 @@ namespace Salsabil {
         //            variableToDriver(driver, column, *from);
         //        }
 
-        inline void driverToVariable(const SqlDriver* driver, int column, int* to) {
-            *to = driver->getInt(column);
-            SALSABIL_LOG_DEBUG("Fetching int value '" + std::to_string(*to) + "' from driver at column '" + std::to_string(column) + "' ");
+        inline void statementToVariable(const SqlStatement* statement, int column, int* to) {
+            *to = statement->getInt(column);
+            SALSABIL_LOG_DEBUG("Fetching int value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, bool* to) {
+            *to = statement->getInt64(column) != 0;
+            SALSABIL_LOG_DEBUG("Fetching bool value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, unsigned* to) {
+            *to = static_cast<unsigned> (statement->getInt64(column));
+            SALSABIL_LOG_DEBUG("Fetching unsigned value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, long* to) {
+            *to = static_cast<long> (statement->getInt64(column));
+            SALSABIL_LOG_DEBUG("Fetching long value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, long long* to) {
+            *to = statement->getInt64(column);
+            SALSABIL_LOG_DEBUG("Fetching long long value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        // negative integers are rejected rather than wrapped around into large unsigned values.
+        inline void statementToVariable(const SqlStatement* statement, int column, unsigned long long* to) {
+            const std::int64_t value = statement->getInt64(column);
+            if (value < 0)
+                throw Exception("Negative value " + std::to_string(value) + " at column '" + std::to_string(column) + "' can't be fetched into an unsigned variable");
+            *to = static_cast<unsigned long long> (value);
+            SALSABIL_LOG_DEBUG("Fetching unsigned long long value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, unsigned long* to) {
+            unsigned long long value;
+            statementToVariable(statement, column, &value);
+            *to = static_cast<unsigned long> (value);
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, std::vector<unsigned char>* to) {
+            // assigning the span reuses the buffer of the vector if it is large enough.
+            SqlBlobSpan span = statement->getBlobSpan(column);
+            const unsigned char* data = static_cast<const unsigned char*> (span.data);
+            if (data)
+                to->assign(data, data + span.size);
+            else
+                to->clear();
+            SALSABIL_LOG_DEBUG("Fetching blob value of size '" + std::to_string(to->size()) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, std::string* to) {
+            // assigning the view reuses the buffer of the string if it is large enough.
+            SqlStringView view = statement->getStringView(column);
+            if (view.data)
+                to->assign(view.data, view.size);
+            else
+                to->clear();
+            SALSABIL_LOG_DEBUG("Fetching string value '" + *to + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, float *to) {
+            *to = statement->getFloat(column);
+            SALSABIL_LOG_DEBUG("Fetching float value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, double *to) {
+            *to = statement->getDouble(column);
+            SALSABIL_LOG_DEBUG("Fetching double value '" + std::to_string(*to) + "' from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        /* 
+         * The value of a field as bound to a statement, e.g. to key or compare instances. Temporal values are mapped to 
+         * integers so that they are hydrated without parsing and range predicates can use an index: a Date is held as its 
+         * number of days since the epoch, a Time as its nanoseconds since midnight and a DateTime as its nanoseconds since 
+         * the epoch, which covers the years 1678 to 2261. A TimeZone is held as its IANA id and a LocalDateTime as a blob 
+         * of its UTC nanoseconds followed by the id of its zone. Invalid values are held as NULLs.
+         */
+        template<typename T>
+        inline SqlValue variableToValue(const T& from) {
+            return SqlValue(from);
+        }
+
+        inline SqlValue variableToValue(const Date& from) {
+            return from.isValid() ? SqlValue(static_cast<long long> (from.toDaysSinceEpoch())) : SqlValue();
+        }
+
+        inline SqlValue variableToValue(const Time& from) {
+            return from.isValid() ? SqlValue(from.toNanosecondsSinceMidnight()) : SqlValue();
+        }
+
+        inline SqlValue variableToValue(const DateTime& from) {
+            return from.isValid() ? SqlValue(from.toNanosecondsSinceEpoch()) : SqlValue();
+        }
+
+        inline SqlValue variableToValue(const TimeZone& from) {
+            return from.isValid() ? SqlValue(from.id()) : SqlValue();
+        }
+
+        // the nanoseconds are written in big-endian order with the sign bit flipped, so that the blobs compare in the order of time.
+        inline SqlValue variableToValue(const LocalDateTime& from) {
+            if (!from.isValid())
+                return SqlValue();
+
+            const std::uint64_t bits = static_cast<std::uint64_t> (from.toUtc().dateTime().toNanosecondsSinceEpoch()) ^ (std::uint64_t(1) << 63);
+            std::string bytes;
+            for (int shift = 56; shift >= 0; shift -= 8)
+                bytes.push_back(static_cast<char> ((bits >> shift) & 0xFF));
+            bytes += from.timeZone().id();
+            return SqlValue::blob(bytes.data(), bytes.size());
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, Date* to) {
+            *to = statement->isNull(column) ? Date() : Date(Date::Days(statement->getInt64(column)));
+            SALSABIL_LOG_DEBUG("Fetching date from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, Time* to) {
+            *to = statement->isNull(column) ? Time() : Time(std::chrono::nanoseconds(statement->getInt64(column)));
+            SALSABIL_LOG_DEBUG("Fetching time from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, DateTime* to) {
+            *to = statement->isNull(column) ? DateTime() : DateTime(std::chrono::nanoseconds(statement->getInt64(column)));
+            SALSABIL_LOG_DEBUG("Fetching datetime from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, TimeZone* to) {
+            *to = statement->isNull(column) ? TimeZone() : TimeZone(statement->getStdString(column));
+            SALSABIL_LOG_DEBUG("Fetching time zone from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void statementToVariable(const SqlStatement* statement, int column, LocalDateTime* to) {
+            SqlBlobSpan span = statement->getBlobSpan(column);
+            const unsigned char* bytes = static_cast<const unsigned char*> (span.data);
+            if (!bytes || span.size <= 8) {
+                *to = LocalDateTime();
+                return;
+            }
+
+            std::uint64_t bits = 0;
+            for (int idx = 0; idx < 8; ++idx)
+                bits = (bits << 8) | bytes[idx];
+            const long long nanoseconds = static_cast<long long> (bits ^ (std::uint64_t(1) << 63));
+            const TimeZone timeZone(std::string(reinterpret_cast<const char*> (bytes) + 8, span.size - 8));
+            *to = LocalDateTime(DateTime(std::chrono::nanoseconds(nanoseconds)), TimeZone::utc()).toTimeZone(timeZone);
+            SALSABIL_LOG_DEBUG("Fetching local datetime from statement at column '" + std::to_string(column) + "' ");
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, Date* from) {
+            variableToValue(*from).bindTo(statement, column);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, Time* from) {
+            variableToValue(*from).bindTo(statement, column);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, DateTime* from) {
+            variableToValue(*from).bindTo(statement, column);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, TimeZone* from) {
+            variableToValue(*from).bindTo(statement, column);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, LocalDateTime* from) {
+            variableToValue(*from).bindTo(statement, column);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, int* from) {
+            SALSABIL_LOG_DEBUG("Binding int variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindInt(column, *from);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, bool* from) {
+            SALSABIL_LOG_DEBUG("Binding bool variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindInt64(column, *from ? 1 : 0);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, unsigned* from) {
+            SALSABIL_LOG_DEBUG("Binding unsigned variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindInt64(column, *from);
+        }
+
+        inline void variableToStatement(SqlStatement* statement, int column, long* from) {
+            SALSABIL_LOG_DEBUG("Binding long variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindInt64(column, *from);
         }
 
-        inline void driverToVariable(const SqlDriver* driver, int column, std::string* to) {
-            *to = driver->getStdString(column);
-            SALSABIL_LOG_DEBUG("Fetching string value '" + *to + "' from driver at column '" + std::to_string(column) + "' ");
+        inline void variableToStatement(SqlStatement* statement, int column, long long* from) {
+            SALSABIL_LOG_DEBUG("Binding long long variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindInt64(column, *from);
         }
 
-        inline void driverToVariable(const SqlDriver* driver, int column, float *to) {
-            *to = driver->getFloat(column);
-            SALSABIL_LOG_DEBUG("Fetching float value '" + std::to_string(*to) + "' from driver at column '" + std::to_string(column) + "' ");
+        // values beyond the range of the signed integers of the statement are rejected rather than wrapped around into negative ones.
+        inline void variableToStatement(SqlStatement* statement, int column, unsigned long long* from) {
+            SALSABIL_LOG_DEBUG("Binding unsigned long long variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            if (*from > static_cast<unsigned long long> (std::numeric_limits<std::int64_t>::max()))
+                throw Exception("Unsigned value " + std::to_string(*from) + " is out of the range of a 64-bit integer");
+            statement->bindInt64(column, static_cast<std::int64_t> (*from));
         }
 
-        inline void driverToVariable(const SqlDriver* driver, int column, double *to) {
-            *to = driver->getDouble(column);
-            SALSABIL_LOG_DEBUG("Fetching double value '" + std::to_string(*to) + "' from driver at column '" + std::to_string(column) + "' ");
+        inline void variableToStatement(SqlStatement* statement, int column, unsigned long* from) {
+            unsigned long long value = *from;
+            variableToStatement(statement, column, &value);
         }
 
-        inline void variableToDriver(SqlDriver* driver, int column, int* from) {
-            SALSABIL_LOG_DEBUG("Binding int variable '" + std::to_string(*from) + "' to driver at column '" + std::to_string(column) + "' ");
-            driver->bindInt(column, *from);
+        inline void variableToStatement(SqlStatement* statement, int column, std::vector<unsigned char>* from) {
+            SALSABIL_LOG_DEBUG("Binding blob variable of size '" + std::to_string(from->size()) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindBlob(column, from->empty() ? nullptr : from->data(), from->size());
         }
 
-        inline void variableToDriver(SqlDriver* driver, int column, std::string* from) {
-            SALSABIL_LOG_DEBUG("Binding string variable '" + *from + "' to driver at column '" + std::to_string(column) + "' ");
-            driver->bindStdString(column, *from);
+        inline void variableToStatement(SqlStatement* statement, int column, std::string* from) {
+            SALSABIL_LOG_DEBUG("Binding string variable '" + *from + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindStdString(column, *from);
         }
 
-        inline void variableToDriver(SqlDriver* driver, int column, float* from) {
-            SALSABIL_LOG_DEBUG("Binding float variable '" + std::to_string(*from) + "' to driver at column '" + std::to_string(column) + "' ");
-            driver->bindFloat(column, *from);
+        inline void variableToStatement(SqlStatement* statement, int column, float* from) {
+            SALSABIL_LOG_DEBUG("Binding float variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindFloat(column, *from);
         }
 
-        inline void variableToDriver(SqlDriver* driver, int column, double* from) {
-            SALSABIL_LOG_DEBUG("Binding double variable '" + std::to_string(*from) + "' to driver at column '" + std::to_string(column) + "' ");
-            driver->bindDouble(column, *from);
+        inline void variableToStatement(SqlStatement* statement, int column, double* from) {
+            SALSABIL_LOG_DEBUG("Binding double variable '" + std::to_string(*from) + "' to statement at column '" + std::to_string(column) + "' ");
+            statement->bindDouble(column, *from);
         }
     }
 }
@@ -35,7 +35,18 @@ DateTime::DateTime(const DateTime& other) : mDate(other.mDate), mTime(other.mTim
 DateTime::DateTime(DateTime&& other) : mDate(std::move(other.mDate)), mTime(std::move(other.mTime)) {
 }
 
-DateTime::DateTime(const Duration& duration) : mDate(std::chrono::duration_cast<Days>(duration)), mTime(duration % Days(1)) {
+namespace {
+
+    // duration_cast truncates toward zero, so the days of an instant before the epoch are rounded down to keep its time of day positive.
+    Date::Days floorDays(const std::chrono::nanoseconds& duration) {
+        Date::Days days = std::chrono::duration_cast<Date::Days>(duration);
+        if (days > duration)
+            days -= Date::Days(1);
+        return days;
+    }
+}
+
+DateTime::DateTime(const Duration& duration) : mDate(floorDays(duration)), mTime(duration - floorDays(duration)) {
 }
 
 DateTime::DateTime(const std::chrono::system_clock::time_point& timePoint)
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SqlConnectionPool.hpp"
+#include "SqlDriver.hpp"
+#include "Exception.hpp"
+
+using namespace Salsabil;
+
+SqlConnectionPool::Connection::Connection(SqlDriver* driver)
+: mPool(nullptr)
+, mDriver(driver) {
+}
+
+SqlConnectionPool::Connection::Connection(SqlConnectionPool* pool, SqlDriver* driver)
+: mPool(pool)
+, mDriver(driver) {
+}
+
+SqlConnectionPool::Connection::Connection(Connection&& other)
+: mPool(other.mPool)
+, mDriver(other.mDriver) {
+    other.mPool = nullptr;
+    other.mDriver = nullptr;
+}
+
+SqlConnectionPool::Connection& SqlConnectionPool::Connection::operator=(Connection&& other) {
+    if (this != &other) {
+        release();
+        mPool = other.mPool;
+        mDriver = other.mDriver;
+        other.mPool = nullptr;
+        other.mDriver = nullptr;
+    }
+    return *this;
+}
+
+SqlConnectionPool::Connection::~Connection() {
+    release();
+}
+
+void SqlConnectionPool::Connection::release() {
+    if (mPool)
+        mPool->giveBack(mDriver);
+
+    mPool = nullptr;
+    mDriver = nullptr;
+}
+
+SqlConnectionPool::SqlConnectionPool(const SqlDriver& prototype, const std::string& databasePath, std::size_t maxReaderCount)
+: mPrototype(prototype.create())
+, mDatabasePath(databasePath)
+, mMaxReaderCount(maxReaderCount)
+, mAcquireTimeout(0)
+, mOpeningReaderCount(0) {
+    if (isInMemory(databasePath))
+        throw Exception("a connection pool can't share the in-memory database '" + databasePath + "' between its connections");
+
+    mWriter.reset(openConnection(false));
+}
+
+SqlConnectionPool::~SqlConnectionPool() {
+}
+
+SqlConnectionPool::Connection SqlConnectionPool::acquireReader() {
+    if (mMaxReaderCount == 0)
+        return acquireWriter();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    const std::thread::id threadId = std::this_thread::get_id();
+    if (mWriterOwner == threadId)
+        return checkOutAgain(mWriter.get());
+
+    auto ownerIter = mReaderOwnerMap.find(threadId);
+    if (ownerIter != mReaderOwnerMap.end())
+        return checkOutAgain(ownerIter->second);
+
+    // a slot is reserved for a new reader, which is opened without holding the lock so that other checkouts don't wait for it.
+    if (mIdleReaderList.empty() && mReaderList.size() + mOpeningReaderCount < mMaxReaderCount) {
+        ++mOpeningReaderCount;
+        lock.unlock();
+
+        std::unique_ptr<SqlDriver> reader;
+        try {
+            reader.reset(openConnection(true));
+        } catch (...) {
+            lock.lock();
+            --mOpeningReaderCount;
+            lock.unlock();
+            mCondition.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        --mOpeningReaderCount;
+        mReaderList.push_back(std::move(reader));
+        mReaderOwnerMap.insert({threadId, mReaderList.back().get()});
+        mCheckoutCountMap[mReaderList.back().get()] = 1;
+
+        return Connection(this, mReaderList.back().get());
+    }
+
+    // a failed opening frees its slot, so the waiting threads check whether they may open a reader themselves.
+    waitFor(lock, [this]() {
+        return !mIdleReaderList.empty() || mReaderList.size() + mOpeningReaderCount < mMaxReaderCount;
+    });
+
+    if (mIdleReaderList.empty()) {
+        lock.unlock();
+        return acquireReader();
+    }
+
+    SqlDriver* reader = mIdleReaderList.back();
+    mIdleReaderList.pop_back();
+    mReaderOwnerMap.insert({threadId, reader});
+    mCheckoutCountMap[reader] = 1;
+
+    return Connection(this, reader);
+}
+
+SqlConnectionPool::Connection SqlConnectionPool::acquireWriter() {
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    const std::thread::id threadId = std::this_thread::get_id();
+    if (mWriterOwner == threadId)
+        return checkOutAgain(mWriter.get());
+
+    waitFor(lock, [this]() {
+        return mWriterOwner == std::thread::id();
+    });
+
+    mWriterOwner = threadId;
+    mCheckoutCountMap[mWriter.get()] = 1;
+
+    return Connection(this, mWriter.get());
+}
+
+void SqlConnectionPool::setAcquireTimeout(std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAcquireTimeout = timeout;
+}
+
+std::chrono::milliseconds SqlConnectionPool::acquireTimeout() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAcquireTimeout;
+}
+
+std::size_t SqlConnectionPool::maxReaderCount() const {
+    return mMaxReaderCount;
+}
+
+std::size_t SqlConnectionPool::readerCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mReaderList.size();
+}
+
+std::size_t SqlConnectionPool::idleReaderCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mIdleReaderList.size();
+}
+
+bool SqlConnectionPool::isInMemory(const std::string& databasePath) {
+    // an empty path opens a private temporary database, as ":memory:" and the URIs of memory databases do.
+    return databasePath.empty() || databasePath == ":memory:" || databasePath.compare(0, 13, "file::memory:") == 0 ||
+            databasePath.find("mode=memory") != std::string::npos;
+}
+
+SqlDriver* SqlConnectionPool::openConnection(bool isReader) {
+    std::unique_ptr<SqlDriver> driver(mPrototype->create());
+    driver->open(mDatabasePath);
+    driver->configurePooledConnection(isReader);
+    return driver.release();
+}
+
+void SqlConnectionPool::waitFor(std::unique_lock<std::mutex>& lock, const std::function<bool()>& isAvailable) {
+    if (mAcquireTimeout.count() == 0) {
+        mCondition.wait(lock, isAvailable);
+    } else if (!mCondition.wait_for(lock, mAcquireTimeout, isAvailable)) {
+        throw Exception("timed out while waiting for a connection to " + mDatabasePath);
+    }
+}
+
+SqlConnectionPool::Connection SqlConnectionPool::checkOutAgain(SqlDriver* driver) {
+    ++mCheckoutCountMap[driver];
+    return Connection(this, driver);
+}
+
+void SqlConnectionPool::giveBack(SqlDriver* driver) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // a connection checked out several times by its thread stays with it until the last handle is released.
+        auto countIter = mCheckoutCountMap.find(driver);
+        if (--countIter->second > 0)
+            return;
+        mCheckoutCountMap.erase(countIter);
+
+        if (driver == mWriter.get()) {
+            mWriterOwner = std::thread::id();
+        } else {
+            mIdleReaderList.push_back(driver);
+            for (auto iter = mReaderOwnerMap.begin(); iter != mReaderOwnerMap.end(); ++iter) {
+                if (iter->second == driver) {
+                    mReaderOwnerMap.erase(iter);
+                    break;
+                }
+            }
+        }
+    }
+
+    mCondition.notify_all();
+}
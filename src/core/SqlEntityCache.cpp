@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SqlEntityCache.hpp"
+#include "SqlDriver.hpp"
+
+#include <map>
+#include <set>
+
+using namespace Salsabil;
+
+namespace {
+
+    // the entries invalidated by each driver during its transaction, by their caches and keys.
+    struct PendingRegistry {
+        std::mutex mutex;
+        std::map<SqlDriver*, std::set<std::pair<SqlEntityCacheBase*, std::string>>> pendingEntryMap;
+    };
+
+    PendingRegistry& pendingRegistry() {
+        static PendingRegistry registry;
+        return registry;
+    }
+}
+
+SqlEntityCacheBase::~SqlEntityCacheBase() {
+    PendingRegistry& registry = pendingRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& pendingEntryPair : registry.pendingEntryMap) {
+        auto& pendingEntrySet = pendingEntryPair.second;
+        for (auto iter = pendingEntrySet.begin(); iter != pendingEntrySet.end();) {
+            if (iter->first == this)
+                iter = pendingEntrySet.erase(iter);
+            else
+                ++iter;
+        }
+    }
+}
+
+void SqlEntityCacheBase::invalidate(SqlDriver* driver, const std::string& key) {
+    invalidate(key);
+    if (driver && driver->isInTransaction()) {
+        PendingRegistry& registry = pendingRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.pendingEntryMap[driver].insert({this, key});
+        driver->onTransactionEnd(&registry, &SqlEntityCacheBase::finishTransaction);
+    }
+}
+
+void SqlEntityCacheBase::finishTransaction(SqlDriver* driver) {
+    PendingRegistry& registry = pendingRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto iter = registry.pendingEntryMap.find(driver);
+    if (iter == registry.pendingEntryMap.end())
+        return;
+
+    for (const auto& pendingEntry : iter->second)
+        pendingEntry.first->invalidate(pendingEntry.second);
+    registry.pendingEntryMap.erase(iter);
+}
@@ -19,6 +19,7 @@
  * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <cassert>
@@ -33,6 +34,10 @@ std::string SqlGenerator::fetchAll(const std::string &table) {
     return "SELECT * FROM " + table;
 }
 
+std::string SqlGenerator::aggregate(const std::string& table, const std::string& function, const std::string& column, const std::string& groupColumn) {
+    return "SELECT " + (groupColumn.empty() ? std::string() : groupColumn + ", ") + function + "(" + column + ") FROM " + table;
+}
+
 std::string SqlGenerator::fetchById(const std::string &table, const std::string& column, const std::string& id) {
     return "SELECT * FROM " + table + " WHERE " + column + " = " + id;
 }
@@ -109,3 +114,102 @@ std::string SqlGenerator::remove(const std::string& table, const std::map<std::s
     statement.erase(statement.end() - 5, statement.end());
     return statement;
 }
+
+std::string SqlGenerator::placeholder(int position) {
+    return "?" + std::to_string(position);
+}
+
+std::string SqlGenerator::preparedFetchById(const std::string& table, const std::vector<std::string>& columnList) {
+    assert(columnList.size() >= 1);
+    return "SELECT * FROM " + table + " WHERE " + preparedCondition(columnList, 1, " AND ");
+}
+
+std::string SqlGenerator::preparedInsert(const std::string& table, const std::vector<std::string>& columnList, std::size_t rowCount) {
+    assert(columnList.size() >= 1);
+    assert(rowCount >= 1);
+    std::vector<std::string> rowList;
+    int position = 1;
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        std::vector<std::string> placeholderList;
+        for (std::size_t idx = 0; idx < columnList.size(); ++idx)
+            placeholderList.push_back(placeholder(position++));
+        rowList.push_back("(" + Utility::join(placeholderList.begin(), placeholderList.end(), ", ") + ")");
+    }
+    return "INSERT INTO " + table + "(" + Utility::join(columnList.begin(), columnList.end(), ", ") + ") VALUES" +
+            Utility::join(rowList.begin(), rowList.end(), ", ");
+}
+
+std::string SqlGenerator::preparedUpsert(const std::string& table, const std::vector<std::string>& columnList, const std::vector<std::string>& conflictColumnList, std::size_t rowCount) {
+    assert(conflictColumnList.size() >= 1);
+    std::vector<std::string> assignmentList;
+    for (const auto& column : columnList) {
+        if (std::find(conflictColumnList.begin(), conflictColumnList.end(), column) == conflictColumnList.end())
+            assignmentList.push_back(column + " = excluded." + column);
+    }
+    return preparedInsert(table, columnList, rowCount) + " ON CONFLICT(" + Utility::join(conflictColumnList.begin(), conflictColumnList.end(), ", ") + ") " +
+            (assignmentList.empty() ? std::string("DO NOTHING") : "DO UPDATE SET " + Utility::join(assignmentList.begin(), assignmentList.end(), ", "));
+}
+
+std::string SqlGenerator::preparedUpdate(const std::string& table, const std::vector<std::string>& columnList, const std::vector<std::string>& whereColumnList) {
+    assert(columnList.size() >= 1);
+    assert(whereColumnList.size() >= 1);
+    return "UPDATE " + table + " SET " + preparedCondition(columnList, 1, ", ") +
+            " WHERE " + preparedCondition(whereColumnList, columnList.size() + 1, " AND ");
+}
+
+std::string SqlGenerator::preparedRemove(const std::string& table, const std::vector<std::string>& whereColumnList) {
+    assert(whereColumnList.size() >= 1);
+    return "DELETE FROM " + table + " WHERE " + preparedCondition(whereColumnList, 1, " AND ");
+}
+
+std::string SqlGenerator::preparedIn(const std::vector<std::string>& columnList, std::size_t rowCount, int firstPosition) {
+    assert(columnList.size() >= 1);
+    assert(rowCount >= 1);
+    std::vector<std::string> rowList;
+    int position = firstPosition;
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        std::vector<std::string> placeholderList;
+        for (std::size_t idx = 0; idx < columnList.size(); ++idx)
+            placeholderList.push_back(placeholder(position++));
+        rowList.push_back(Utility::join(placeholderList.begin(), placeholderList.end(), ", "));
+    }
+    if (columnList.size() == 1)
+        return columnList.front() + " IN (" + Utility::join(rowList.begin(), rowList.end(), ", ") + ")";
+    return "(" + Utility::join(columnList.begin(), columnList.end(), ", ") + ") IN (VALUES(" + Utility::join(rowList.begin(), rowList.end(), "), (") + "))";
+}
+
+std::string SqlGenerator::preparedExists(const std::string& table, const std::vector<std::string>& columnList) {
+    assert(columnList.size() >= 1);
+    return "SELECT 1 FROM " + table + " WHERE " + preparedCondition(columnList, 1, " AND ") + " LIMIT 1";
+}
+
+std::string SqlGenerator::preparedSeek(const std::vector<std::string>& columnList, int firstPosition) {
+    assert(columnList.size() >= 1);
+    std::vector<std::string> placeholderList;
+    for (std::size_t idx = 0; idx < columnList.size(); ++idx)
+        placeholderList.push_back(placeholder(firstPosition + idx));
+    if (columnList.size() == 1)
+        return columnList.front() + " > " + placeholderList.front();
+    return "(" + Utility::join(columnList.begin(), columnList.end(), ", ") + ") > (" + Utility::join(placeholderList.begin(), placeholderList.end(), ", ") + ")";
+}
+
+std::string SqlGenerator::preparedSelect(const std::string& selection, const std::vector<std::string>& conditionList, const std::vector<std::string>& orderList, int limitPosition,
+        const std::vector<std::string>& groupList) {
+    std::string sqlStatement = selection;
+    if (!conditionList.empty())
+        sqlStatement += " WHERE " + Utility::join(conditionList.begin(), conditionList.end(), " AND ");
+    if (!groupList.empty())
+        sqlStatement += " GROUP BY " + Utility::join(groupList.begin(), groupList.end(), ", ");
+    if (!orderList.empty())
+        sqlStatement += " ORDER BY " + Utility::join(orderList.begin(), orderList.end(), ", ");
+    if (limitPosition > 0)
+        sqlStatement += " LIMIT " + placeholder(limitPosition) + " OFFSET " + placeholder(limitPosition + 1);
+    return sqlStatement;
+}
+
+std::string SqlGenerator::preparedCondition(const std::vector<std::string>& columnList, int firstPosition, const std::string& delimiter) {
+    std::vector<std::string> conditionList;
+    for (const auto& column : columnList)
+        conditionList.push_back(column + " = " + placeholder(firstPosition++));
+    return Utility::join(conditionList.begin(), conditionList.end(), delimiter);
+}
@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SqlQueryCache.hpp"
+#include "SqlDriver.hpp"
+#include "SqlStatement.hpp"
+#include "internal/SqlValue.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <map>
+
+using namespace Salsabil;
+
+namespace {
+
+    // the table versions are shared by all caches, so that writes invalidate the results of every cache reading the table.
+    struct TableRegistry {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::uint64_t> versionMap;
+        std::map<SqlDriver*, std::vector<std::string>> pendingTableMap;
+    };
+
+    TableRegistry& tableRegistry() {
+        static TableRegistry registry;
+        return registry;
+    }
+
+    // collapses each run of whitespace into a single space, so that queries differing only in layout share their results.
+    // Quoted literals and identifiers are kept as they are, since their whitespace is part of their values.
+    std::string normalize(const std::string& sqlStatement) {
+        std::string normalized;
+        normalized.reserve(sqlStatement.size());
+        char quote = '\0';
+        for (char c : sqlStatement) {
+            if (quote != '\0') {
+                // an escaped quote, which is doubled, closes the quotation and opens it again right away.
+                if (c == quote)
+                    quote = '\0';
+                normalized.push_back(c);
+            } else if (std::isspace(static_cast<unsigned char> (c))) {
+                if (!normalized.empty() && normalized.back() != ' ')
+                    normalized.push_back(' ');
+            } else {
+                if (c == '\'' || c == '"' || c == '`')
+                    quote = c;
+                normalized.push_back(c);
+            }
+        }
+        if (!normalized.empty() && normalized.back() == ' ')
+            normalized.pop_back();
+        return normalized;
+    }
+}
+
+class SqlQueryCache::CachedStatement : public SqlStatement {
+public:
+
+    CachedStatement(SqlQueryCache* cache, SqlDriver* driver, const std::string& sqlStatement, const std::vector<std::string>& tableNameList)
+    : mCache(cache)
+    , mDriver(driver)
+    , mSqlStatement(sqlStatement)
+    , mNormalizedStatement(normalize(sqlStatement))
+    , mTableNameList(tableNameList)
+    , mRow(nullptr)
+    , mRowIndex(0) {
+    }
+
+    void execute() override {
+        const std::string& key = cacheKey();
+
+        mCapture.reset();
+        mRow = nullptr;
+        mRowIndex = 0;
+        mResult = mCache->find(key);
+        if (mResult) {
+            ++mCache->mHitCount;
+            return;
+        }
+        ++mCache->mMissCount;
+
+        // the versions are taken before running the query, so a write committed meanwhile makes the result stale right away.
+        mCapture.reset(new Result());
+        mCapture->size = key.size();
+        for (const auto& tableName : mTableNameList)
+            mCapture->tableVersionList.push_back({tableName, SqlQueryCache::tableVersion(tableName)});
+        mKey = key;
+
+        if (mStatement)
+            mStatement->reset();
+        else
+            mStatement.reset(mDriver->createStatement(mSqlStatement));
+
+        for (const auto& binding : mBindingMap)
+            binding.second.bindTo(mStatement.get(), binding.first);
+
+        mStatement->execute();
+        mCapture->columnCount = mStatement->columnCount();
+    }
+
+    // queries never violate constraints.
+    bool tryExecute() override {
+        execute();
+        return true;
+    }
+
+    bool nextRow() override {
+        if (mResult) {
+            if (mRowIndex == mResult->rowList.size()) {
+                mRow = nullptr;
+                return false;
+            }
+            mRow = &mResult->rowList[mRowIndex++];
+            return true;
+        }
+
+        if (!mStatement->nextRow()) {
+            if (mCapture) {
+                mCache->insert(mKey, std::move(mCapture));
+                mCapture.reset();
+            }
+            return false;
+        }
+
+        if (mCapture)
+            capture();
+        return true;
+    }
+
+    void reset() override {
+        mBindingMap.clear();
+        mResult.reset();
+        mCapture.reset();
+        mRow = nullptr;
+        mRowIndex = 0;
+        if (mStatement)
+            mStatement->reset();
+    }
+
+    int columnCount() const override {
+        return mResult ? mResult->columnCount : mStatement->columnCount();
+    }
+
+    bool isNull(int columnIndex) const override {
+        return mResult ? value(columnIndex).isNull : mStatement->isNull(columnIndex);
+    }
+
+    int getInt(int columnIndex) const override {
+        return mResult ? static_cast<int> (value(columnIndex).integer) : mStatement->getInt(columnIndex);
+    }
+
+    int64_t getInt64(int columnIndex) const override {
+        return mResult ? value(columnIndex).integer : mStatement->getInt64(columnIndex);
+    }
+
+    float getFloat(int columnIndex) const override {
+        return mResult ? static_cast<float> (value(columnIndex).real) : mStatement->getFloat(columnIndex);
+    }
+
+    double getDouble(int columnIndex) const override {
+        return mResult ? value(columnIndex).real : mStatement->getDouble(columnIndex);
+    }
+
+    const unsigned char* getRawString(int columnIndex) const override {
+        return reinterpret_cast<const unsigned char*> (getCString(columnIndex));
+    }
+
+    const char* getCString(int columnIndex) const override {
+        if (!mResult)
+            return mStatement->getCString(columnIndex);
+        const Value& v = value(columnIndex);
+        return v.isNull ? nullptr : v.bytes.c_str();
+    }
+
+    std::string getStdString(int columnIndex) const override {
+        return mResult ? value(columnIndex).bytes : mStatement->getStdString(columnIndex);
+    }
+
+    std::size_t getSize(int columnIndex) const override {
+        return mResult ? value(columnIndex).bytes.size() : mStatement->getSize(columnIndex);
+    }
+
+    const void* getBlob(int columnIndex) const override {
+        if (!mResult)
+            return mStatement->getBlob(columnIndex);
+        const Value& v = value(columnIndex);
+        return v.bytes.empty() ? nullptr : v.bytes.data();
+    }
+
+    SqlStringView getStringView(int columnIndex) const override {
+        if (!mResult)
+            return mStatement->getStringView(columnIndex);
+        const Value& v = value(columnIndex);
+        return SqlStringView{v.isNull ? nullptr : v.bytes.data(), v.bytes.size()};
+    }
+
+    SqlBlobSpan getBlobSpan(int columnIndex) const override {
+        return SqlBlobSpan{getBlob(columnIndex), getSize(columnIndex)};
+    }
+
+    void bindNull(int position) const override {
+        bind(position, SqlValue());
+    }
+
+    void bindInt(int position, int value) const override {
+        bind(position, SqlValue(value));
+    }
+
+    void bindInt64(int position, int64_t value) const override {
+        bind(position, SqlValue(value));
+    }
+
+    void bindFloat(int position, float value) const override {
+        bind(position, SqlValue(value));
+    }
+
+    void bindDouble(int position, double value) const override {
+        bind(position, SqlValue(value));
+    }
+
+    void bindCString(int position, const char* str) const override {
+        if (str)
+            bind(position, SqlValue(std::string(str)));
+        else
+            bindNull(position);
+    }
+
+    void bindStdString(int position, const std::string& str) const override {
+        bind(position, SqlValue(str));
+    }
+
+    void bindBlob(int position, const void* blob, std::size_t size) const override {
+        bind(position, SqlValue::blob(blob, size));
+    }
+
+private:
+
+    void bind(int position, SqlValue&& binding) const {
+        mBindingMap[position] = std::move(binding);
+    }
+
+    // the normalized query followed by the type and value of each binding; text and blobs are prefixed by their sizes, so keys can't be ambiguous.
+    std::string cacheKey() const {
+        std::string key = mNormalizedStatement;
+        for (const auto& binding : mBindingMap) {
+            const SqlValue& value = binding.second;
+            key += '\0' + std::to_string(binding.first) + ':';
+            switch (value.type()) {
+                case SqlValue::Type::Null:
+                    key += 'n';
+                    break;
+                case SqlValue::Type::Integer:
+                    key += 'i' + std::to_string(value.toInt64());
+                    break;
+                case SqlValue::Type::Real:
+                {
+                    char bits[sizeof (double)];
+                    const double real = value.toDouble();
+                    std::memcpy(bits, &real, sizeof (double));
+                    key += 'r';
+                    key.append(bits, sizeof (double));
+                    break;
+                }
+                case SqlValue::Type::Text:
+                    key += 't' + std::to_string(value.text().size()) + ':' + value.text();
+                    break;
+                case SqlValue::Type::Blob:
+                    key += 'b' + std::to_string(value.text().size()) + ':' + value.text();
+                    break;
+            }
+        }
+        return key;
+    }
+
+    // copies the current row of the underlying statement into the captured result, unless the result outgrows the cache.
+    void capture() {
+        std::vector<Value> row(mCapture->columnCount);
+        std::size_t size = sizeof (row) + row.size() * sizeof (Value);
+        for (int column = 0; column < mCapture->columnCount; ++column) {
+            Value& v = row[column];
+            v.isNull = mStatement->isNull(column);
+            if (v.isNull) {
+                v.integer = 0;
+                v.real = 0;
+                continue;
+            }
+            v.integer = mStatement->getInt64(column);
+            v.real = mStatement->getDouble(column);
+            const SqlBlobSpan span = mStatement->getBlobSpan(column);
+            v.bytes.assign(static_cast<const char*> (span.data), span.data ? span.size : 0);
+            size += v.bytes.size();
+        }
+
+        mCapture->size += size;
+        if (mCapture->size > mCache->memoryBudget())
+            mCapture.reset();
+        else
+            mCapture->rowList.push_back(std::move(row));
+    }
+
+    const Value& value(int columnIndex) const {
+        return (*mRow)[columnIndex];
+    }
+
+    SqlQueryCache* mCache;
+    SqlDriver* mDriver;
+    std::string mSqlStatement;
+    std::string mNormalizedStatement;
+    std::vector<std::string> mTableNameList;
+    mutable std::map<int, SqlValue> mBindingMap;
+
+    std::unique_ptr<SqlStatement> mStatement;
+    std::shared_ptr<const Result> mResult;
+    const std::vector<Value>* mRow;
+    std::size_t mRowIndex;
+    std::unique_ptr<Result> mCapture;
+    std::string mKey;
+};
+
+SqlQueryCache::SqlQueryCache(std::size_t memoryBudget)
+: mMemoryBudget(memoryBudget)
+, mMemoryUsage(0)
+, mHitCount(0)
+, mMissCount(0) {
+}
+
+SqlQueryCache::~SqlQueryCache() {
+}
+
+SqlStatement* SqlQueryCache::createStatement(SqlDriver* driver, const std::string& sqlStatement, const std::vector<std::string>& tableNameList) {
+    return new CachedStatement(this, driver, sqlStatement, tableNameList);
+}
+
+void SqlQueryCache::clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntryMap.clear();
+    mEntryList.clear();
+    mMemoryUsage = 0;
+}
+
+std::size_t SqlQueryCache::size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntryList.size();
+}
+
+std::size_t SqlQueryCache::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMemoryUsage;
+}
+
+std::size_t SqlQueryCache::memoryBudget() const {
+    return mMemoryBudget;
+}
+
+std::uint64_t SqlQueryCache::hitCount() const {
+    return mHitCount;
+}
+
+std::uint64_t SqlQueryCache::missCount() const {
+    return mMissCount;
+}
+
+void SqlQueryCache::invalidateTable(SqlDriver* driver, const std::string& tableName) {
+    TableRegistry& registry = tableRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ++registry.versionMap[tableName];
+    if (driver && driver->isInTransaction()) {
+        registry.pendingTableMap[driver].push_back(tableName);
+        driver->onTransactionEnd(&registry, &SqlQueryCache::finishTransaction);
+    }
+}
+
+std::uint64_t SqlQueryCache::tableVersion(const std::string& tableName) {
+    TableRegistry& registry = tableRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto iter = registry.versionMap.find(tableName);
+    return iter == registry.versionMap.end() ? 0 : iter->second;
+}
+
+void SqlQueryCache::finishTransaction(SqlDriver* driver) {
+    TableRegistry& registry = tableRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto iter = registry.pendingTableMap.find(driver);
+    if (iter == registry.pendingTableMap.end())
+        return;
+
+    for (const auto& tableName : iter->second)
+        ++registry.versionMap[tableName];
+    registry.pendingTableMap.erase(iter);
+}
+
+std::shared_ptr<const SqlQueryCache::Result> SqlQueryCache::find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mEntryMap.find(key);
+    if (iter == mEntryMap.end())
+        return nullptr;
+
+    const std::shared_ptr<const Result> result = iter->second->result;
+    for (const auto& tableVersion : result->tableVersionList) {
+        if (SqlQueryCache::tableVersion(tableVersion.first) != tableVersion.second) {
+            mMemoryUsage -= result->size;
+            mEntryList.erase(iter->second);
+            mEntryMap.erase(iter);
+            return nullptr;
+        }
+    }
+
+    mEntryList.splice(mEntryList.begin(), mEntryList, iter->second);
+    return result;
+}
+
+void SqlQueryCache::insert(const std::string& key, std::shared_ptr<const Result> result) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mEntryMap.find(key);
+    if (iter != mEntryMap.end()) {
+        mMemoryUsage -= iter->second->result->size;
+        mEntryList.erase(iter->second);
+        mEntryMap.erase(iter);
+    }
+
+    if (result->size > mMemoryBudget)
+        return;
+
+    while (mMemoryUsage + result->size > mMemoryBudget) {
+        const Entry& leastRecentlyUsed = mEntryList.back();
+        mMemoryUsage -= leastRecentlyUsed.result->size;
+        mEntryMap.erase(leastRecentlyUsed.key);
+        mEntryList.pop_back();
+    }
+
+    mMemoryUsage += result->size;
+    mEntryList.push_front(Entry{key, std::move(result)});
+    mEntryMap[key] = mEntryList.begin();
+}
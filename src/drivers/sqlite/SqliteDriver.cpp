@@ -20,16 +20,33 @@
  */
 
 #include "SqliteDriver.hpp"
+#include "SqliteStatement.hpp"
 #include "Exception.hpp"
 #include "sqlite3/sqlite3.h"
 
 #include <iostream>
+#include <list>
+#include <unordered_map>
 
 using namespace Salsabil;
 
+struct SqliteDriver::StatementCache {
+    using EntryList = std::list<std::pair<std::string, sqlite3_stmt*>>;
+
+    // the most recently used statements are kept at the front of the list.
+    EntryList entryList;
+    std::unordered_map<std::string, EntryList::iterator> entryIndex;
+};
+
+const std::size_t SqliteDriver::DefaultStatementCacheCapacity;
+
 SqliteDriver::SqliteDriver()
 : mHandle(nullptr)
-, mStatement(nullptr) {
+, mStatement(new SqliteStatement(this))
+, mStatementCache(new StatementCache)
+, mStatementCacheCapacity(DefaultStatementCacheCapacity)
+, mStatementCacheHitCount(0)
+, mStatementCacheMissCount(0) {
 }
 
 std::string SqliteDriver::driverName() const {
@@ -37,7 +54,9 @@ std::string SqliteDriver::driverName() const {
 }
 
 SqliteDriver* SqliteDriver::create() const {
-    return new SqliteDriver;
+    SqliteDriver* driver = new SqliteDriver;
+    driver->setStatementCacheCapacity(mStatementCacheCapacity);
+    return driver;
 }
 
 void SqliteDriver::open(const std::string& databaseFileName) {
@@ -56,6 +75,9 @@ bool SqliteDriver::isOpen() const {
 }
 
 void SqliteDriver::close() {
+    mStatement->release();
+    evictStatements(0);
+
     int code = sqlite3_close_v2(mHandle);
     if (code != SQLITE_OK) {
         const char* fileName = sqlite3_db_filename(mHandle, "main");
@@ -64,28 +86,24 @@ void SqliteDriver::close() {
                 " with error code " + std::to_string(code) + " " + sqlite3_errmsg(mHandle));
     }
     mHandle = nullptr;
+
+    // closing the connection rolls back the transaction in progress, if any.
+    finishTransaction();
+}
+
+SqlStatement* SqliteDriver::createStatement(const std::string& sqlStatement) {
+    return new SqliteStatement(this, sqlStatement);
 }
 
 void SqliteDriver::prepare(const std::string& sqlStatement) {
-    int code = sqlite3_prepare_v2(mHandle, sqlStatement.c_str(), -1, &mStatement, nullptr);
-    if (code != SQLITE_OK) {
-        throw Exception("Error occured while preparing " + sqlStatement + " with error code " +
-                std::to_string(code) + " " + sqlite3_errmsg(mHandle));
-    }
-    mDelayCycleFlag = true;
-    mNextFetchFlag = false;
+    mStatement->prepare(sqlStatement);
 }
 
 void SqliteDriver::execute() {
-    int code = sqlite3_step(mStatement);
-    if (code == SQLITE_ROW) {
-        mNextFetchFlag = true;
-    } else if (code == SQLITE_DONE) {
-        finalize();
-        mNextFetchFlag = false;
-    } else {
-        throw Exception("Error occured while executing with error code " + std::to_string(code) + " " + sqlite3_errmsg(mHandle));
-    }
+    mStatement->step();
+    // a finished statement is given back to the cache right away, since it cannot be stepped any further.
+    if (!mStatement->mNextFetchFlag)
+        mStatement->release();
 }
 
 void SqliteDriver::execute(const std::string& sqlStatement) {
@@ -94,125 +112,126 @@ void SqliteDriver::execute(const std::string& sqlStatement) {
 }
 
 bool SqliteDriver::nextRow() {
-    if (mDelayCycleFlag) {
-        mDelayCycleFlag = false;
-        return mNextFetchFlag;
+    if (mStatement->mDelayCycleFlag) {
+        mStatement->mDelayCycleFlag = false;
+        return mStatement->mNextFetchFlag;
     }
 
     execute();
-    return mNextFetchFlag;
+    return mStatement->mNextFetchFlag;
 }
 
 bool SqliteDriver::isNull(int columnIndex) const {
-    return sqlite3_column_type(mStatement, columnIndex) == SQLITE_NULL;
+    return mStatement->isNull(columnIndex);
 }
 
 int SqliteDriver::getInt(int columnIndex) const {
-    return sqlite3_column_int(mStatement, columnIndex);
+    return mStatement->getInt(columnIndex);
 }
 
 int64_t SqliteDriver::getInt64(int columnIndex) const {
-    return sqlite3_column_int64(mStatement, columnIndex);
+    return mStatement->getInt64(columnIndex);
 }
 
 float SqliteDriver::getFloat(int columnIndex) const {
-    return static_cast<float> (getDouble(columnIndex));
+    return mStatement->getFloat(columnIndex);
 }
 
 double SqliteDriver::getDouble(int columnIndex) const {
-    return sqlite3_column_double(mStatement, columnIndex);
+    return mStatement->getDouble(columnIndex);
 }
 
 const unsigned char* SqliteDriver::getRawString(int columnIndex) const {
-    return sqlite3_column_text(mStatement, columnIndex);
+    return mStatement->getRawString(columnIndex);
 }
 
 const char* SqliteDriver::getCString(int columnIndex) const {
-    return reinterpret_cast<const char*> (getRawString(columnIndex));
+    return mStatement->getCString(columnIndex);
 }
 
 std::string SqliteDriver::getStdString(int columnIndex) const {
-    return std::string(getCString(columnIndex));
+    return mStatement->getStdString(columnIndex);
 }
 
 std::size_t SqliteDriver::getSize(int columnIndex) const {
-    return sqlite3_column_bytes(mStatement, columnIndex);
+    return mStatement->getSize(columnIndex);
 }
 
 const void* SqliteDriver::getBlob(int columnIndex) const {
-    return sqlite3_column_blob(mStatement, columnIndex);
+    return mStatement->getBlob(columnIndex);
+}
+
+SqlStringView SqliteDriver::getStringView(int columnIndex) const {
+    return mStatement->getStringView(columnIndex);
+}
+
+SqlBlobSpan SqliteDriver::getBlobSpan(int columnIndex) const {
+    return mStatement->getBlobSpan(columnIndex);
 }
 
 void SqliteDriver::bindNull(int position) const {
-    int errorCode = sqlite3_bind_null(mStatement, position);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter at position " + std::to_string(position) +
-                " with error code " + std::to_string(errorCode) + " " + sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindNull(position);
 }
 
 void SqliteDriver::bindInt(int position, int value) const {
-    int errorCode = sqlite3_bind_int(mStatement, position, value);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter at position " + std::to_string(position) +
-                " with error code " + std::to_string(errorCode) + " " + sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindInt(position, value);
 }
 
 void SqliteDriver::bindInt64(int position, int64_t value) const {
-    int errorCode = sqlite3_bind_int64(mStatement, position, value);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter at position " + std::to_string(position) +
-                " with error code " + std::to_string(errorCode) + " " + sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindInt64(position, value);
 }
 
 void SqliteDriver::bindFloat(int position, float value) const {
-    bindDouble(position, value);
+    mStatement->bindFloat(position, value);
 }
 
 void SqliteDriver::bindDouble(int position, double value) const {
-    int errorCode = sqlite3_bind_double(mStatement, position, value);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter at position " + std::to_string(position) +
-                " with error code " + std::to_string(errorCode) + " " + sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindDouble(position, value);
 }
 
 void SqliteDriver::bindCString(int position, const char* str) const {
-    int errorCode = sqlite3_bind_text(mStatement, position, str, -1, SQLITE_TRANSIENT);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter " + std::string(str) + " at position " +
-                std::to_string(position) + " with error code " + std::to_string(errorCode) + " " +
-                sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindCString(position, str);
 }
 
 void SqliteDriver::bindStdString(int position, const std::string & str) const {
-    int errorCode = sqlite3_bind_text(mStatement, position, str.c_str(), -1, SQLITE_TRANSIENT);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter " + str + " at position " +
-                std::to_string(position) + " with error code " + std::to_string(errorCode) + " " +
-                sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindStdString(position, str);
 }
 
 void SqliteDriver::bindBlob(int position, const void* blob, std::size_t size) const {
-    int errorCode = sqlite3_bind_blob(mStatement, position, blob, size, SQLITE_TRANSIENT);
-    if (errorCode != SQLITE_OK) {
-        throw Exception("Error occured while binding parameter at position " + std::to_string(position) +
-                " with error code " + std::to_string(errorCode) + " " + sqlite3_errmsg(mHandle));
-    }
+    mStatement->bindBlob(position, blob, size);
+}
+
+bool SqliteDriver::isInTransaction() const {
+    return mHandle != nullptr && sqlite3_get_autocommit(mHandle) == 0;
+}
+
+int SqliteDriver::maxPlaceholderCount() const {
+    if (mHandle == nullptr)
+        return SqlDriver::maxPlaceholderCount();
+
+    return sqlite3_limit(mHandle, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+}
+
+void SqliteDriver::configurePooledConnection(bool isReader) {
+    // the statements are finished right away, a pending row would keep a transaction open on the connection.
+    auto executePragma = [this](const std::string & pragma) {
+        std::unique_ptr<SqlStatement> statement(createStatement(pragma));
+        statement->execute();
+    };
+
+    // concurrent connections wait for each other's locks instead of failing right away.
+    executePragma("PRAGMA busy_timeout = 5000");
+    executePragma(isReader ? "PRAGMA query_only = ON" : "PRAGMA journal_mode = WAL");
 }
 
 std::vector<std::string> SqliteDriver::tableList() {
     std::vector<std::string> tables;
 
     try {
-        prepare("SELECT name FROM sqlite_master WHERE type='table'");
-        execute();
-        while (nextRow()) {
-            tables.push_back(getStdString(0));
+        SqliteStatement statement(this, "SELECT name FROM sqlite_master WHERE type='table'");
+        statement.execute();
+        while (statement.nextRow()) {
+            tables.push_back(statement.getStdString(0));
         }
 
     } catch (Exception &exp) {
@@ -226,10 +245,10 @@ std::vector<std::string> SqliteDriver::columnList(const std::string& table) {
     std::vector<std::string> columns;
 
     try {
-        prepare("PRAGMA table_info(" + table + ")");
-        execute();
-        while (nextRow()) {
-            columns.push_back(getStdString(1));
+        SqliteStatement statement(this, "PRAGMA table_info(" + table + ")");
+        statement.execute();
+        while (statement.nextRow()) {
+            columns.push_back(statement.getStdString(1));
         }
 
     } catch (Exception &exp) {
@@ -239,13 +258,83 @@ std::vector<std::string> SqliteDriver::columnList(const std::string& table) {
     return columns;
 }
 
-void SqliteDriver::finalize() {
-    int code = sqlite3_finalize(mStatement);
+void SqliteDriver::setStatementCacheCapacity(std::size_t capacity) {
+    mStatementCacheCapacity = capacity;
+    evictStatements(capacity);
+}
+
+std::size_t SqliteDriver::statementCacheCapacity() const {
+    return mStatementCacheCapacity;
+}
+
+std::size_t SqliteDriver::statementCacheSize() const {
+    return mStatementCache->entryList.size();
+}
+
+std::size_t SqliteDriver::statementCacheHitCount() const {
+    return mStatementCacheHitCount;
+}
+
+std::size_t SqliteDriver::statementCacheMissCount() const {
+    return mStatementCacheMissCount;
+}
+
+sqlite3_stmt* SqliteDriver::acquireStatement(const std::string& sqlStatement) {
+    auto indexIter = mStatementCache->entryIndex.find(sqlStatement);
+    if (indexIter != mStatementCache->entryIndex.end()) {
+        sqlite3_stmt* statement = indexIter->second->second;
+        mStatementCache->entryList.erase(indexIter->second);
+        mStatementCache->entryIndex.erase(indexIter);
+        ++mStatementCacheHitCount;
+        return statement;
+    }
+
+    ++mStatementCacheMissCount;
+
+    sqlite3_stmt* statement = nullptr;
+    int code = sqlite3_prepare_v3(mHandle, sqlStatement.c_str(), static_cast<int> (sqlStatement.size() + 1),
+            mStatementCacheCapacity > 0 ? SQLITE_PREPARE_PERSISTENT : 0, &statement, nullptr);
     if (code != SQLITE_OK) {
-        std::cerr << "Error occured while finalizing the last statement with error code " +
-                std::to_string(code) + " " + sqlite3_errmsg(mHandle) << std::endl;
+        sqlite3_finalize(statement);
+        throw Exception("Error occured while preparing " + sqlStatement + " with error code " +
+                std::to_string(code) + " " + sqlite3_errmsg(mHandle));
+    }
+    return statement;
+}
+
+void SqliteDriver::releaseStatement(sqlite3_stmt* statement) {
+    // the result of the last step is reported by sqlite3_reset() as well, it has already been handled while stepping.
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    // a statement with the same text may have been cached while this one was in use.
+    const std::string sqlStatement(sqlite3_sql(statement));
+    if (isOpen() && mStatementCacheCapacity > 0 && mStatementCache->entryIndex.find(sqlStatement) == mStatementCache->entryIndex.end()) {
+        mStatementCache->entryList.push_front({sqlStatement, statement});
+        mStatementCache->entryIndex.insert({sqlStatement, mStatementCache->entryList.begin()});
+        evictStatements(mStatementCacheCapacity);
+    } else {
+        int code = sqlite3_finalize(statement);
+        if (code != SQLITE_OK) {
+            std::cerr << "Error occured while finalizing the last statement with error code " +
+                    std::to_string(code) + " " + sqlite3_errmsg(mHandle) << std::endl;
+        }
+    }
+}
+
+void SqliteDriver::evictStatements(std::size_t capacity) {
+    if (!mStatementCache)
+        return;
+
+    while (mStatementCache->entryList.size() > capacity) {
+        int code = sqlite3_finalize(mStatementCache->entryList.back().second);
+        if (code != SQLITE_OK) {
+            std::cerr << "Error occured while finalizing a cached statement with error code " +
+                    std::to_string(code) + " " + sqlite3_errmsg(mHandle) << std::endl;
+        }
+        mStatementCache->entryIndex.erase(mStatementCache->entryList.back().first);
+        mStatementCache->entryList.pop_back();
     }
-    mStatement = nullptr;
 }
 
 SqliteDriver::~SqliteDriver() {
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SqliteStatement.hpp"
+#include "SqliteDriver.hpp"
+#include "Exception.hpp"
+#include "sqlite3/sqlite3.h"
+
+using namespace Salsabil;
+
+SqliteStatement::SqliteStatement(SqliteDriver* driver)
+: mDriver(driver)
+, mStatement(nullptr)
+, mNextFetchFlag(false)
+, mDelayCycleFlag(false) {
+}
+
+SqliteStatement::SqliteStatement(SqliteDriver* driver, const std::string& sqlStatement)
+: SqliteStatement(driver) {
+    prepare(sqlStatement);
+}
+
+void SqliteStatement::prepare(const std::string& sqlStatement) {
+    release();
+    mStatement = mDriver->acquireStatement(sqlStatement);
+    mDelayCycleFlag = true;
+    mNextFetchFlag = false;
+}
+
+bool SqliteStatement::step(bool isConflictExpected) {
+    int code = sqlite3_step(mStatement);
+    if (code == SQLITE_ROW) {
+        mNextFetchFlag = true;
+    } else if (code == SQLITE_DONE) {
+        mNextFetchFlag = false;
+    } else if (isConflictExpected && (code & 0xff) == SQLITE_CONSTRAINT) {
+        // the extended codes of constraint violations share the primary code in their lowest byte.
+        mNextFetchFlag = false;
+        return false;
+    } else {
+        throw Exception("Error occured while executing with error code " + std::to_string(code) + " " + sqlite3_errmsg(sqlite3_db_handle(mStatement)));
+    }
+    return true;
+}
+
+void SqliteStatement::release() {
+    if (mStatement == nullptr)
+        return;
+
+    mDriver->releaseStatement(mStatement);
+    mStatement = nullptr;
+}
+
+void SqliteStatement::execute() {
+    step();
+    mDelayCycleFlag = true;
+}
+
+bool SqliteStatement::tryExecute() {
+    const bool isExecuted = step(true);
+    mDelayCycleFlag = true;
+    return isExecuted;
+}
+
+bool SqliteStatement::nextRow() {
+    if (mDelayCycleFlag) {
+        mDelayCycleFlag = false;
+        return mNextFetchFlag;
+    }
+
+    // stepping a finished statement would run it once more from the beginning.
+    if (!mNextFetchFlag)
+        return false;
+
+    step();
+    return mNextFetchFlag;
+}
+
+void SqliteStatement::reset() {
+    sqlite3_reset(mStatement);
+    sqlite3_clear_bindings(mStatement);
+    mNextFetchFlag = false;
+    mDelayCycleFlag = false;
+}
+
+int SqliteStatement::columnCount() const {
+    return sqlite3_column_count(mStatement);
+}
+
+bool SqliteStatement::isNull(int columnIndex) const {
+    return sqlite3_column_type(mStatement, columnIndex) == SQLITE_NULL;
+}
+
+int SqliteStatement::getInt(int columnIndex) const {
+    return sqlite3_column_int(mStatement, columnIndex);
+}
+
+int64_t SqliteStatement::getInt64(int columnIndex) const {
+    return sqlite3_column_int64(mStatement, columnIndex);
+}
+
+float SqliteStatement::getFloat(int columnIndex) const {
+    return static_cast<float> (getDouble(columnIndex));
+}
+
+double SqliteStatement::getDouble(int columnIndex) const {
+    return sqlite3_column_double(mStatement, columnIndex);
+}
+
+const unsigned char* SqliteStatement::getRawString(int columnIndex) const {
+    return sqlite3_column_text(mStatement, columnIndex);
+}
+
+const char* SqliteStatement::getCString(int columnIndex) const {
+    return reinterpret_cast<const char*> (getRawString(columnIndex));
+}
+
+std::string SqliteStatement::getStdString(int columnIndex) const {
+    return getStringView(columnIndex).toStdString();
+}
+
+std::size_t SqliteStatement::getSize(int columnIndex) const {
+    return sqlite3_column_bytes(mStatement, columnIndex);
+}
+
+const void* SqliteStatement::getBlob(int columnIndex) const {
+    return sqlite3_column_blob(mStatement, columnIndex);
+}
+
+SqlStringView SqliteStatement::getStringView(int columnIndex) const {
+    // the size must be queried after the conversion to text, see sqlite3_column_bytes().
+    const char* data = getCString(columnIndex);
+    return SqlStringView{data, getSize(columnIndex)};
+}
+
+SqlBlobSpan SqliteStatement::getBlobSpan(int columnIndex) const {
+    const void* data = getBlob(columnIndex);
+    return SqlBlobSpan{data, getSize(columnIndex)};
+}
+
+void SqliteStatement::throwBindingError(int errorCode, int position, const std::string& value) const {
+    throw Exception("Error occured while binding parameter " + (value.empty() ? std::string() : value + " ") +
+            "at position " + std::to_string(position) + " with error code " + std::to_string(errorCode) + " " +
+            sqlite3_errmsg(sqlite3_db_handle(mStatement)));
+}
+
+void SqliteStatement::bindNull(int position) const {
+    int errorCode = sqlite3_bind_null(mStatement, position);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, std::string());
+}
+
+void SqliteStatement::bindInt(int position, int value) const {
+    int errorCode = sqlite3_bind_int(mStatement, position, value);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, std::string());
+}
+
+void SqliteStatement::bindInt64(int position, int64_t value) const {
+    int errorCode = sqlite3_bind_int64(mStatement, position, value);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, std::string());
+}
+
+void SqliteStatement::bindFloat(int position, float value) const {
+    bindDouble(position, value);
+}
+
+void SqliteStatement::bindDouble(int position, double value) const {
+    int errorCode = sqlite3_bind_double(mStatement, position, value);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, std::string());
+}
+
+void SqliteStatement::bindCString(int position, const char* str) const {
+    int errorCode = sqlite3_bind_text(mStatement, position, str, -1, SQLITE_TRANSIENT);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, str);
+}
+
+void SqliteStatement::bindStdString(int position, const std::string& str) const {
+    int errorCode = sqlite3_bind_text(mStatement, position, str.data(), static_cast<int> (str.size()), SQLITE_TRANSIENT);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, str);
+}
+
+void SqliteStatement::bindBlob(int position, const void* blob, std::size_t size) const {
+    int errorCode = sqlite3_bind_blob(mStatement, position, blob, size, SQLITE_TRANSIENT);
+    if (errorCode != SQLITE_OK)
+        throwBindingError(errorCode, position, std::string());
+}
+
+SqliteStatement::~SqliteStatement() {
+    release();
+}
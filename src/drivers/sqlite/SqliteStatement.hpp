@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SALSABIL_SQLITESTATEMENT_HPP
+#define SALSABIL_SQLITESTATEMENT_HPP
+
+#include "SqlStatement.hpp"
+
+struct sqlite3_stmt;
+
+namespace Salsabil {
+    class SqliteDriver;
+
+    /* 
+     * SqliteStatement wraps a compiled SQLite statement taken from the statement cache of the driver 
+     * that created it, and gives it back to the cache once the statement is released or destroyed. 
+     */
+    class SqliteStatement : public SqlStatement {
+    public:
+        virtual ~SqliteStatement();
+
+        virtual void execute();
+
+        virtual bool tryExecute();
+
+        virtual bool nextRow();
+
+        virtual void reset();
+
+        virtual int columnCount() const;
+
+        virtual bool isNull(int columnIndex) const;
+
+        virtual int getInt(int columnIndex) const;
+
+        virtual int64_t getInt64(int columnIndex) const;
+
+        virtual float getFloat(int columnIndex) const;
+
+        virtual double getDouble(int columnIndex) const;
+
+        virtual const unsigned char* getRawString(int columnIndex) const;
+
+        virtual const char* getCString(int columnIndex) const;
+
+        virtual std::string getStdString(int columnIndex) const;
+
+        virtual std::size_t getSize(int columnIndex) const;
+
+        virtual const void* getBlob(int columnIndex) const;
+
+        virtual SqlStringView getStringView(int columnIndex) const;
+
+        virtual SqlBlobSpan getBlobSpan(int columnIndex) const;
+
+        virtual void bindNull(int position) const;
+
+        virtual void bindInt(int position, int value) const;
+
+        virtual void bindInt64(int position, int64_t value) const;
+
+        virtual void bindFloat(int position, float value) const;
+
+        virtual void bindDouble(int position, double value) const;
+
+        virtual void bindCString(int position, const char* str) const;
+
+        virtual void bindStdString(int position, const std::string& str) const;
+
+        virtual void bindBlob(int position, const void* blob, std::size_t size) const;
+
+    private:
+        friend class SqliteDriver;
+
+        explicit SqliteStatement(SqliteDriver* driver);
+        SqliteStatement(SqliteDriver* driver, const std::string& sqlStatement);
+
+        SqliteStatement(const SqliteStatement&) = delete;
+        SqliteStatement& operator=(const SqliteStatement&) = delete;
+
+        void prepare(const std::string& sqlStatement);
+        bool step(bool isConflictExpected = false);
+        void release();
+        void throwBindingError(int errorCode, int position, const std::string& value) const;
+
+        SqliteDriver* mDriver;
+        sqlite3_stmt* mStatement;
+        bool mNextFetchFlag;
+        bool mDelayCycleFlag;
+    };
+}
+#endif // SALSABIL_SQLITESTATEMENT_HPP
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "mocks/ClassMock.hpp"
+#include "Exception.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlConnectionPool.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlRepository.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Salsabil;
+
+namespace {
+
+    // a driver whose opening waits while the gate is closed, to hold a reader being opened by the pool.
+    class GatedDriver : public SqliteDriver {
+    public:
+        static std::atomic<bool> isGateClosed;
+        static std::atomic<int> waitingCount;
+
+        virtual GatedDriver* create() const {
+            return new GatedDriver;
+        }
+
+        virtual void open(const std::string& databaseFileName) {
+            ++waitingCount;
+            while (isGateClosed)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --waitingCount;
+            SqliteDriver::open(databaseFileName);
+        }
+    };
+
+    std::atomic<bool> GatedDriver::isGateClosed(false);
+    std::atomic<int> GatedDriver::waitingCount(0);
+
+    // an entity which runs a hook when it is move-assigned, e.g. while a stream holding it is.
+    struct Probe {
+        int id;
+        std::string name;
+        float weight;
+
+        static std::function<void()> onMoveAssign;
+
+        Probe() : id(0), weight(0) {
+        }
+
+        Probe(const Probe&) = default;
+
+        Probe& operator=(const Probe&) = default;
+
+        Probe& operator=(Probe&& other) {
+            if (onMoveAssign)
+                onMoveAssign();
+            id = other.id;
+            name = std::move(other.name);
+            weight = other.weight;
+            return *this;
+        }
+    };
+
+    std::function<void()> Probe::onMoveAssign;
+}
+
+TEST_CASE("SqlConnectionPool") {
+    const std::string databasePath = "salsabil_connection_pool_test.db";
+    std::ofstream(databasePath.c_str());
+
+    SqliteDriver prototype;
+
+    {
+        SqlConnectionPool pool(prototype, databasePath, 2);
+        {
+            SqlConnectionPool::Connection writer = pool.acquireWriter();
+            writer->execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+            writer->execute("PRAGMA journal_mode");
+            REQUIRE(writer->nextRow());
+            CHECK(writer->getStdString(0) == "wal");
+            REQUIRE_FALSE(writer->nextRow());
+        }
+
+        SUBCASE("OpensReadersOnDemandUpToTheLimit") {
+            CHECK(pool.maxReaderCount() == 2u);
+            CHECK(pool.readerCount() == 0u);
+
+            SqlConnectionPool::Connection first = pool.acquireReader();
+            CHECK(pool.readerCount() == 1u);
+            CHECK(pool.idleReaderCount() == 0u);
+
+            std::thread([&pool]() {
+                SqlConnectionPool::Connection second = pool.acquireReader();
+                CHECK(pool.readerCount() == 2u);
+            }).join();
+
+            CHECK(pool.readerCount() == 2u);
+            CHECK(pool.idleReaderCount() == 1u);
+        }
+
+        SUBCASE("HandsOutTheSameConnectionToTheSameThread") {
+            SqlConnectionPool::Connection reader = pool.acquireReader();
+            SqlConnectionPool::Connection nestedReader = pool.acquireReader();
+            CHECK(reader.driver() == nestedReader.driver());
+            CHECK(pool.readerCount() == 1u);
+
+            SqlConnectionPool::Connection writer = pool.acquireWriter();
+            SqlConnectionPool::Connection nestedWriter = pool.acquireWriter();
+            CHECK(writer.driver() == nestedWriter.driver());
+            CHECK(writer.driver() != reader.driver());
+        }
+
+        SUBCASE("KeepsConnectionsUntilTheirLastHandleIsReleased") {
+            pool.setAcquireTimeout(std::chrono::milliseconds(10));
+
+            std::unique_ptr<SqlConnectionPool::Connection> nestedReader;
+            {
+                SqlConnectionPool::Connection reader = pool.acquireReader();
+                nestedReader.reset(new SqlConnectionPool::Connection(pool.acquireReader()));
+            }
+            CHECK(pool.idleReaderCount() == 0u);
+            nestedReader.reset();
+            CHECK(pool.idleReaderCount() == 1u);
+
+            std::unique_ptr<SqlConnectionPool::Connection> nestedWriter;
+            {
+                SqlConnectionPool::Connection writer = pool.acquireWriter();
+                nestedWriter.reset(new SqlConnectionPool::Connection(pool.acquireReader()));
+            }
+            bool hasThrown = false;
+            std::thread([&pool, &hasThrown]() {
+                try {
+                    pool.acquireWriter();
+                } catch (const Exception&) {
+                    hasThrown = true;
+                }
+            }).join();
+            CHECK(hasThrown);
+
+            nestedWriter.reset();
+            std::thread([&pool]() {
+                CHECK_NOTHROW(pool.acquireWriter());
+            }).join();
+        }
+
+        SUBCASE("ReadsThroughTheWriterWhileHoldingIt") {
+            SqlConnectionPool::Connection writer = pool.acquireWriter();
+            SqlConnectionPool::Connection reader = pool.acquireReader();
+            CHECK(reader.driver() == writer.driver());
+        }
+
+        SUBCASE("ThrowsIfTheDatabaseIsInMemory") {
+            REQUIRE_THROWS_AS(SqlConnectionPool(prototype, ":memory:", 2), Exception);
+            REQUIRE_THROWS_AS(SqlConnectionPool(prototype, "", 2), Exception);
+            REQUIRE_THROWS_AS(SqlConnectionPool(prototype, "file::memory:?cache=shared", 2), Exception);
+            REQUIRE_THROWS_AS(SqlConnectionPool(prototype, "file:shared?mode=memory&cache=shared", 2), Exception);
+        }
+
+        SUBCASE("OpensReadersWithoutHoldingUpOtherCheckouts") {
+            GatedDriver gatedPrototype;
+            SqlConnectionPool gatedPool(gatedPrototype, databasePath, 1);
+
+            GatedDriver::isGateClosed = true;
+            std::thread opener([&gatedPool]() {
+                SqlConnectionPool::Connection reader = gatedPool.acquireReader();
+                CHECK(reader.driver() != nullptr);
+            });
+            while (GatedDriver::waitingCount == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            {
+                SqlConnectionPool::Connection writer = gatedPool.acquireWriter();
+                CHECK(gatedPool.readerCount() == 0u);
+            }
+
+            GatedDriver::isGateClosed = false;
+            opener.join();
+            CHECK(gatedPool.readerCount() == 1u);
+            CHECK(gatedPool.idleReaderCount() == 1u);
+        }
+
+        SUBCASE("ReadersAreQueryOnly") {
+            SqlConnectionPool::Connection reader = pool.acquireReader();
+            REQUIRE_THROWS_AS(reader->execute("INSERT INTO person VALUES(1, 'Ali', 60)"), Exception);
+        }
+
+        SUBCASE("ThrowsIfNoConnectionIsReturnedInTime") {
+            pool.setAcquireTimeout(std::chrono::milliseconds(10));
+            CHECK(pool.acquireTimeout() == std::chrono::milliseconds(10));
+
+            SqlConnectionPool::Connection writer = pool.acquireWriter();
+            bool hasThrown = false;
+            std::thread([&pool, &hasThrown]() {
+                try {
+                    pool.acquireWriter();
+                } catch (const Exception&) {
+                    hasThrown = true;
+                }
+            }).join();
+            CHECK(hasThrown);
+        }
+
+        SUBCASE("WaitsForConnectionsToBeReturned") {
+            SqlConnectionPool::Connection writer = pool.acquireWriter();
+            std::atomic<bool> isAcquired(false);
+            std::thread waiter([&pool, &isAcquired]() {
+                SqlConnectionPool::Connection connection = pool.acquireWriter();
+                isAcquired = true;
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            CHECK_FALSE(isAcquired);
+
+            SqlConnectionPool::Connection released = std::move(writer);
+            released = SqlConnectionPool::Connection(nullptr);
+            waiter.join();
+            CHECK(isAcquired);
+        }
+
+        SUBCASE("StreamsFinishTheirStatementsBeforeGivingBackTheirReaders") {
+            SqlConnectionPool singleReaderPool(prototype, databasePath, 1);
+            singleReaderPool.setAcquireTimeout(std::chrono::milliseconds(10));
+            {
+                SqlConnectionPool::Connection writer = singleReaderPool.acquireWriter();
+                writer->execute("INSERT INTO person VALUES(1, 'Ali', 60)");
+                writer->execute("INSERT INTO person VALUES(2, 'Ruby', 70)");
+            }
+
+            SqlEntityConfigurer<Probe> conf;
+            conf.setConnectionPool(&singleReaderPool);
+            conf.setTableName("person");
+            conf.setPrimaryField("id", &Probe::id);
+            conf.setField("name", &Probe::name);
+            conf.setField("weight", &Probe::weight);
+
+            SqlRepository<Probe>::Stream stream = SqlRepository<Probe>::stream();
+            REQUIRE(stream.begin() != stream.end());
+
+            // the replacement reads through the writer, so the reader of the live stream is the only one given back.
+            std::unique_ptr<SqlRepository<Probe>::Stream> replacement;
+            {
+                SqlConnectionPool::Connection writer = singleReaderPool.acquireWriter();
+                replacement.reset(new SqlRepository<Probe>::Stream(SqlRepository<Probe>::stream()));
+            }
+
+            // the instance is moved after the statement and before the connection, so no other thread gets the reader meanwhile.
+            bool isReaderAcquiredMidAssignment = false;
+            Probe::onMoveAssign = [&singleReaderPool, &isReaderAcquiredMidAssignment]() {
+                std::thread([&singleReaderPool, &isReaderAcquiredMidAssignment]() {
+                    try {
+                        SqlConnectionPool::Connection reader = singleReaderPool.acquireReader();
+                        isReaderAcquiredMidAssignment = true;
+                    } catch (const Exception&) {
+                    }
+                }).join();
+            };
+            stream = std::move(*replacement);
+            Probe::onMoveAssign = nullptr;
+            CHECK_FALSE(isReaderAcquiredMidAssignment);
+
+            std::thread([&singleReaderPool]() {
+                SqlConnectionPool::Connection reader = singleReaderPool.acquireReader();
+                reader->execute("SELECT count(*) FROM person");
+                CHECK(reader->nextRow());
+            }).join();
+        }
+
+        SUBCASE("RepositoryDrawsConnectionsFromThePool") {
+            SqlEntityConfigurer<ClassMock> conf;
+            conf.setConnectionPool(&pool);
+            conf.setTableName("person");
+            conf.setPrimaryField("id", &ClassMock::id);
+            conf.setField("name", &ClassMock::name);
+            conf.setField("weight", &ClassMock::weight);
+
+            for (int id = 1; id <= 8; ++id) {
+                ClassMock obj;
+                obj.id = id;
+                obj.name = "name" + std::to_string(id);
+                obj.weight = id;
+                SqlRepository<ClassMock>::persist(&obj);
+            }
+
+            std::atomic<int> matchCount(0);
+            std::vector<std::thread> readerList;
+            for (int threadIndex = 0; threadIndex < 4; ++threadIndex) {
+                readerList.push_back(std::thread([&matchCount]() {
+                    for (int id = 1; id <= 8; ++id) {
+                        ClassMock* obj = SqlRepository<ClassMock>::fetch(id);
+                        if (obj->name == "name" + std::to_string(id))
+                            ++matchCount;
+                        delete obj;
+                    }
+                }));
+            }
+            for (auto& reader : readerList)
+                reader.join();
+
+            CHECK(matchCount == 32);
+            CHECK(pool.readerCount() <= 2u);
+
+            conf.setConnectionPool(nullptr);
+        }
+    }
+
+    std::remove(databasePath.c_str());
+    std::remove((databasePath + "-wal").c_str());
+    std::remove((databasePath + "-shm").c_str());
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "mocks/ClassMock.hpp"
+#include "Exception.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlConnectionPool.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlEntityCache.hpp"
+#include "SqlRepository.hpp"
+#include "SqlTransaction.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+using namespace Salsabil;
+
+TEST_CASE("SqlEntityCache") {
+    ClassMock obj;
+    obj.setId(1);
+    obj.setName("Ali");
+
+    SUBCASE(" counts hits and misses ") {
+        SqlEntityCache<ClassMock> cache(1 << 16);
+        ClassMock cachedObj;
+        CHECK_FALSE(cache.get("1", &cachedObj));
+
+        cache.put("1", obj);
+        REQUIRE(cache.get("1", &cachedObj));
+        CHECK(cachedObj.getName() == "Ali");
+        CHECK(cache.size() == 1);
+        CHECK(cache.hitCount() == 1);
+        CHECK(cache.missCount() == 1);
+
+        cache.invalidate("1");
+        CHECK_FALSE(cache.get("1", &cachedObj));
+        CHECK(cache.size() == 0);
+        CHECK(cache.memoryUsage() == 0);
+    }
+
+    SUBCASE(" evicts the least recently used entries beyond the memory budget ") {
+        SqlEntityCache<ClassMock> probe(1024, 1);
+        probe.put("1", obj);
+        const std::size_t entrySize = probe.memoryUsage();
+
+        SqlEntityCache<ClassMock> cache(2 * entrySize, 1);
+        ClassMock cachedObj;
+        cache.put("1", obj);
+        cache.put("2", obj);
+        REQUIRE(cache.get("1", &cachedObj));
+
+        cache.put("3", obj);
+        CHECK(cache.size() == 2);
+        CHECK(cache.get("1", &cachedObj));
+        CHECK_FALSE(cache.get("2", &cachedObj));
+        CHECK(cache.get("3", &cachedObj));
+        CHECK(cache.evictionCount() == 1);
+        CHECK(cache.memoryUsage() <= cache.memoryBudget());
+    }
+
+    SUBCASE(" drops stale loads that raced with an invalidation ") {
+        SqlEntityCache<ClassMock> cache(1 << 16);
+        std::uint64_t generation = cache.generation("1");
+        cache.invalidate("1");
+        cache.put("1", obj, generation);
+        CHECK(cache.size() == 0);
+    }
+
+    SUBCASE(" throws if there are no shards ") {
+        REQUIRE_THROWS_AS(SqlEntityCache<ClassMock>(1024, 0), Exception);
+    }
+
+    SUBCASE(" forgets the invalidations of drivers destroyed within their transactions ") {
+        SqlEntityCache<ClassMock> cache(1 << 16);
+        ClassMock cachedObj;
+        std::unique_ptr<SqliteDriver> drv(new SqliteDriver);
+        drv->open(":memory:");
+        drv->beginTransaction();
+        cache.invalidate(drv.get(), "1");
+
+        // the entry is cached by another thread before the transaction ends with its driver, which invalidates it again.
+        cache.put("1", obj);
+        drv.reset();
+        CHECK_FALSE(cache.get("1", &cachedObj));
+    }
+}
+
+TEST_CASE("SqlRepository with an entity cache") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+    drv.execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
+
+    SqlEntityConfigurer<ClassMock> conf;
+    conf.setDriver(&drv);
+    conf.setTableName("person");
+    conf.setPrimaryField("id", &ClassMock::id);
+    conf.setField("name", &ClassMock::name);
+    conf.setField("weight", &ClassMock::weight);
+
+    SqlEntityCache<ClassMock> cache(1 << 20);
+    conf.setEntityCache(&cache);
+
+    SUBCASE(" serves repeated fetches from the cache ") {
+        std::unique_ptr<ClassMock> obj(SqlRepository<ClassMock>::fetch(1));
+        CHECK(cache.missCount() == 1);
+
+        // the row is changed behind the repository's back, so only a cached copy still has the old name.
+        drv.execute("UPDATE person SET name = 'Omar' WHERE id = 1");
+        std::unique_ptr<ClassMock> cachedObj(SqlRepository<ClassMock>::fetch(1));
+        CHECK(cache.hitCount() == 1);
+        CHECK(cachedObj->name == "Ali");
+        CHECK(cachedObj.get() != obj.get());
+    }
+
+    SUBCASE(" invalidates updated and removed entities ") {
+        std::unique_ptr<ClassMock> obj(SqlRepository<ClassMock>::fetch(1));
+        obj->name = "Omar";
+        SqlRepository<ClassMock>::update(obj.get());
+        CHECK(cache.size() == 0);
+        CHECK(std::unique_ptr<ClassMock>(SqlRepository<ClassMock>::fetch(1))->name == "Omar");
+
+        SqlRepository<ClassMock>::remove(obj.get());
+        CHECK(cache.size() == 0);
+        REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetch(1), Exception);
+    }
+
+    SUBCASE(" caches persisted entities ") {
+        std::vector<ClassMock> objList(2);
+        objList.at(0).id = 2;
+        objList.at(0).name = "Ruby";
+        objList.at(1).id = 3;
+        objList.at(1).name = "Zaid";
+        SqlRepository<ClassMock>::persistAll(objList.begin(), objList.end());
+        CHECK(cache.size() == 2);
+
+        std::unique_ptr<ClassMock> cachedObj(SqlRepository<ClassMock>::fetch(3));
+        CHECK(cache.hitCount() == 1);
+        CHECK(cachedObj->name == "Zaid");
+
+        SqlRepository<ClassMock>::removeAll(objList.begin(), objList.end());
+        CHECK(cache.size() == 0);
+    }
+
+    SUBCASE(" invalidates entities again as their enclosing transaction ends ") {
+        const std::string databasePath = "salsabil_entity_cache_test.db";
+        std::ofstream(databasePath.c_str());
+        {
+            SqlConnectionPool pool(drv, databasePath, 1);
+            {
+                SqlConnectionPool::Connection writer = pool.acquireWriter();
+                writer->execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+                writer->execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
+            }
+            conf.setConnectionPool(&pool);
+
+            std::unique_ptr<ClassMock> obj(SqlRepository<ClassMock>::fetch(1));
+            {
+                SqlConnectionPool::Connection writer = pool.acquireWriter();
+                SqlTransaction transaction(writer.driver());
+                obj->name = "Omar";
+                SqlRepository<ClassMock>::update(obj.get());
+                CHECK(cache.size() == 0);
+
+                // another thread still reads the committed row, and caches it as its entry has been invalidated already.
+                std::thread([]() {
+                    CHECK(std::unique_ptr<ClassMock>(SqlRepository<ClassMock>::fetch(1))->name == "Ali");
+                }).join();
+                CHECK(cache.size() == 1);
+
+                transaction.commit();
+            }
+            CHECK(cache.size() == 0);
+            CHECK(std::unique_ptr<ClassMock>(SqlRepository<ClassMock>::fetch(1))->name == "Omar");
+
+            conf.setConnectionPool(nullptr);
+        }
+        std::remove(databasePath.c_str());
+        std::remove((databasePath + "-wal").c_str());
+        std::remove((databasePath + "-shm").c_str());
+    }
+
+    conf.setEntityCache(nullptr);
+}
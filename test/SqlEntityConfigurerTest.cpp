@@ -89,6 +89,31 @@ TEST_CASE("SqlEntityConfigurer") {
         REQUIRE(conf.primaryFieldList().size() == 1);
     }
 
+    SUBCASE("BuildStatementsOnceConfigured") {
+        REQUIRE(conf.fetchByIdStatement().isEmpty());
+        REQUIRE(conf.insertStatement().isEmpty());
+
+        conf.setPrimaryField("id", ClassMock::getId, ClassMock::setId);
+        conf.setField("name", ClassMock::getName, ClassMock::setName);
+        conf.setField("weight", &ClassMock::weight);
+
+        REQUIRE(conf.fetchByIdStatement().text() == "SELECT * FROM person WHERE id = ?1");
+        REQUIRE(conf.insertStatement().text() == "INSERT INTO person(id, name, weight) VALUES(?1, ?2, ?3)");
+        REQUIRE(conf.updateStatement().text() == "UPDATE person SET name = ?1, weight = ?2 WHERE id = ?3");
+        REQUIRE(conf.removeStatement().text() == "DELETE FROM person WHERE id = ?1");
+
+        SqlEntityConfigurer<ClassMock> conf2;
+        REQUIRE(conf2.fetchByIdStatement().isEmpty());
+        REQUIRE(conf2.updateStatement().isEmpty());
+    }
+
+    SUBCASE("SkipUpdateStatementIfThereIsNothingToSet") {
+        conf.setPrimaryField("id", ClassMock::getId, ClassMock::setId);
+
+        REQUIRE(conf.insertStatement().text() == "INSERT INTO person(id) VALUES(?1)");
+        REQUIRE(conf.updateStatement().isEmpty());
+    }
+
     SUBCASE("ResetStaticConfigurationAfterConstruction") {
         conf.setPrimaryField("id", ClassMock::getId, ClassMock::setId);
         conf.setField("name", ClassMock::getName, ClassMock::setName);
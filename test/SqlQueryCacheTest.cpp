@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "mocks/UserMock.hpp"
+#include "mocks/SessionMock.hpp"
+#include "Exception.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlQueryCache.hpp"
+#include "SqlRepository.hpp"
+#include "SqlTransaction.hpp"
+
+#include <cstring>
+
+using namespace Salsabil;
+
+TEST_CASE("SqlQueryCache") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight double, picture blob)");
+    drv.execute("INSERT INTO person(id, name, weight, picture) values(1, 'Ali', 80.123456789012345, x'00ff10')");
+    drv.execute("INSERT INTO person(id, name, weight, picture) values(2, NULL, 53.8, NULL)");
+
+    SqlQueryCache cache(1 << 20);
+    std::unique_ptr<SqlStatement> statement(cache.createStatement(&drv, "SELECT name, weight, picture FROM person  WHERE id = ?1", {"person"}));
+
+    SUBCASE(" serves repeated queries until their table is invalidated ") {
+        statement->bindInt(1, 1);
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        CHECK(statement->getStdString(0) == "Ali");
+        CHECK_FALSE(statement->nextRow());
+        CHECK(cache.size() == 1);
+        CHECK(cache.missCount() == 1);
+
+        // the row is changed behind the cache's back, so only a cached result still has the old name.
+        drv.execute("UPDATE person SET name = 'Omar' WHERE id = 1");
+        statement->reset();
+        statement->bindInt(1, 1);
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        CHECK(statement->getStdString(0) == "Ali");
+        CHECK(cache.hitCount() == 1);
+
+        SqlQueryCache::invalidateTable(&drv, "person");
+        statement->reset();
+        statement->bindInt(1, 1);
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        CHECK(statement->getStdString(0) == "Omar");
+        CHECK(cache.missCount() == 2);
+    }
+
+    SUBCASE(" keys results by the normalized query and its bindings ") {
+        statement->bindInt(1, 1);
+        statement->execute();
+        while (statement->nextRow());
+
+        statement->reset();
+        statement->bindInt(1, 2);
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        CHECK(statement->isNull(0));
+        CHECK(cache.missCount() == 2);
+
+        std::unique_ptr<SqlStatement> relaidStatement(cache.createStatement(&drv, "SELECT name, weight, picture\n FROM person WHERE id = ?1", {"person"}));
+        relaidStatement->bindInt(1, 1);
+        relaidStatement->execute();
+        REQUIRE(relaidStatement->nextRow());
+        CHECK(relaidStatement->getStdString(0) == "Ali");
+        CHECK(cache.hitCount() == 1);
+    }
+
+    SUBCASE(" keeps the whitespace of quoted literals in the key ") {
+        drv.execute("INSERT INTO person(id, name, weight, picture) values(3, 'a  b', 60, NULL)");
+
+        std::unique_ptr<SqlStatement> doubleSpaced(cache.createStatement(&drv, "SELECT id FROM person WHERE name = 'a  b'", {"person"}));
+        doubleSpaced->execute();
+        REQUIRE(doubleSpaced->nextRow());
+        CHECK(doubleSpaced->getInt(0) == 3);
+        CHECK_FALSE(doubleSpaced->nextRow());
+
+        std::unique_ptr<SqlStatement> singleSpaced(cache.createStatement(&drv, "SELECT id   FROM person WHERE name = 'a b'", {"person"}));
+        singleSpaced->execute();
+        CHECK_FALSE(singleSpaced->nextRow());
+        CHECK(cache.hitCount() == 0);
+
+        std::unique_ptr<SqlStatement> relaid(cache.createStatement(&drv, "SELECT id\nFROM person WHERE name = 'a  b'", {"person"}));
+        relaid->execute();
+        REQUIRE(relaid->nextRow());
+        CHECK(relaid->getInt(0) == 3);
+        CHECK(cache.hitCount() == 1);
+    }
+
+    SUBCASE(" replays the values of the cached rows ") {
+        for (int pass = 0; pass < 2; ++pass) {
+            statement->reset();
+            statement->bindInt(1, 1);
+            statement->execute();
+            REQUIRE(statement->nextRow());
+            CHECK(statement->columnCount() == 3);
+            CHECK(statement->getDouble(1) == 80.123456789012345);
+            CHECK(statement->getSize(2) == 3);
+            CHECK(std::memcmp(statement->getBlob(2), "\x00\xff\x10", 3) == 0);
+            CHECK(std::string(statement->getCString(0)) == "Ali");
+            CHECK_FALSE(statement->nextRow());
+        }
+        CHECK(cache.hitCount() == 1);
+
+        statement->reset();
+        statement->bindInt(1, 2);
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        statement->reset();
+        statement->bindInt(1, 2);
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        CHECK(statement->isNull(0));
+        CHECK(statement->getCString(0) == nullptr);
+        CHECK(statement->getStringView(0).data == nullptr);
+        CHECK(statement->getBlob(2) == nullptr);
+        CHECK(statement->getFloat(1) == 53.8f);
+    }
+
+    SUBCASE(" doesn't cache partially fetched results ") {
+        std::unique_ptr<SqlStatement> allStatement(cache.createStatement(&drv, "SELECT id FROM person", {"person"}));
+        allStatement->execute();
+        REQUIRE(allStatement->nextRow());
+        CHECK(cache.size() == 0);
+    }
+
+    SUBCASE(" doesn't cache results beyond the memory budget ") {
+        SqlQueryCache tinyCache(16);
+        std::unique_ptr<SqlStatement> tinyStatement(tinyCache.createStatement(&drv, "SELECT id FROM person", {"person"}));
+        tinyStatement->execute();
+        while (tinyStatement->nextRow());
+        CHECK(tinyCache.size() == 0);
+        CHECK(tinyCache.memoryUsage() == 0);
+    }
+}
+
+TEST_CASE("SqlRepository with a query cache") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table user (id int NOT NULL PRIMARY KEY, name varchar(20))");
+    drv.execute("create table session (id int NOT NULL PRIMARY KEY, time varchar(20), user_id int)");
+    drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+    drv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+
+    SqlEntityConfigurer<SessionMock> sessionConfig;
+    sessionConfig.setDriver(&drv);
+    sessionConfig.setTableName("session");
+    sessionConfig.setPrimaryField("id", &SessionMock::id);
+    sessionConfig.setField("time", &SessionMock::time);
+
+    SqlEntityConfigurer<UserMock> userConfig;
+    userConfig.setDriver(&drv);
+    userConfig.setTableName("user");
+    userConfig.setPrimaryField("id", &UserMock::id);
+    userConfig.setField("name", &UserMock::name);
+    userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id");
+
+    SqlQueryCache cache(1 << 20);
+    sessionConfig.setQueryCache(&cache);
+    userConfig.setQueryCache(&cache);
+
+    auto fetchAllUsers = []() {
+        std::vector<UserMock*> userList = SqlRepository<UserMock>::fetchAll();
+        std::vector<std::string> timeList;
+        for (auto user : userList) {
+            for (auto session : user->sessions) {
+                timeList.push_back(session->time);
+                delete session;
+            }
+            delete user;
+        }
+        return timeList;
+    };
+
+    SUBCASE(" serves the queries of entities and their relations ") {
+        CHECK(fetchAllUsers() == std::vector<std::string>{"2018-01-23T08:54:22"});
+        CHECK(cache.missCount() == 2);
+        CHECK(fetchAllUsers() == std::vector<std::string>{"2018-01-23T08:54:22"});
+        CHECK(cache.hitCount() == 2);
+    }
+
+    SUBCASE(" invalidates the results read from the tables written by repositories ") {
+        fetchAllUsers();
+
+        SessionMock session;
+        session.id = 1;
+        session.time = "2018-01-27T01:48:44";
+        SqlRepository<SessionMock>::update(&session);
+
+        CHECK(fetchAllUsers() == std::vector<std::string>{"2018-01-27T01:48:44"});
+        CHECK(cache.hitCount() == 1);
+        CHECK(cache.missCount() == 3);
+    }
+
+    SUBCASE(" invalidates again once the enclosing transaction ends ") {
+        fetchAllUsers();
+
+        SqlTransaction transaction(&drv);
+        SessionMock session;
+        session.id = 1;
+        session.time = "2018-01-27T01:48:44";
+        SqlRepository<SessionMock>::update(&session);
+        const std::uint64_t version = SqlQueryCache::tableVersion("session");
+
+        // queries inside the transaction bypass the cache.
+        CHECK(fetchAllUsers() == std::vector<std::string>{"2018-01-27T01:48:44"});
+        CHECK(cache.hitCount() == 0);
+        transaction.commit();
+
+        CHECK(SqlQueryCache::tableVersion("session") > version);
+        CHECK(fetchAllUsers() == std::vector<std::string>{"2018-01-27T01:48:44"});
+    }
+
+    SUBCASE(" invalidates again once a transaction begun on the driver ends ") {
+        drv.beginTransaction();
+        SessionMock session;
+        session.id = 1;
+        session.time = "2018-01-27T01:48:44";
+        SqlRepository<SessionMock>::update(&session);
+        const std::uint64_t version = SqlQueryCache::tableVersion("session");
+        drv.commit();
+        CHECK(SqlQueryCache::tableVersion("session") > version);
+
+        drv.setSavepoint("sp");
+        SqlRepository<SessionMock>::update(&session);
+        const std::uint64_t savepointVersion = SqlQueryCache::tableVersion("session");
+        drv.releaseSavepoint("sp");
+        CHECK(SqlQueryCache::tableVersion("session") > savepointVersion);
+    }
+
+    sessionConfig.setQueryCache(nullptr);
+    userConfig.setQueryCache(nullptr);
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "mocks/ClassMock.hpp"
+#include "mocks/UserMock.hpp"
+#include "mocks/SessionMock.hpp"
+#include "Exception.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlQuery.hpp"
+#include "SqlRepository.hpp"
+
+using namespace Salsabil;
+
+namespace {
+
+    std::vector<int> idList(const std::vector<ClassMock*>& objList) {
+        std::vector<int> ids;
+        for (auto obj : objList) {
+            ids.push_back(obj->id);
+            delete obj;
+        }
+        return ids;
+    }
+}
+
+TEST_CASE("SqlQuery") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+    drv.execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
+    drv.execute("INSERT INTO person(id, name, weight) values(2, 'Ruby', 53.8)");
+    drv.execute("INSERT INTO person(id, name, weight) values(3, 'Amir', 91.2)");
+    drv.execute("INSERT INTO person(id, name, weight) values(4, NULL, 70)");
+
+    SqlEntityConfigurer<ClassMock> conf;
+    conf.setDriver(&drv);
+    conf.setTableName("person");
+    conf.setPrimaryField("id", &ClassMock::id);
+    conf.setField("name", &ClassMock::getName, &ClassMock::setName);
+    conf.setField("weight", &ClassMock::weight);
+
+    SUBCASE(" compiles to a statement with placeholders ") {
+        SqlQuery<ClassMock> query;
+        query.greaterThan(&ClassMock::weight, 60).like(&ClassMock::getName, "A%").orderBy(&ClassMock::id, SortOrder::Descending).limit(2);
+        CHECK(query.text("SELECT * FROM person") == "SELECT * FROM person WHERE person.weight > ?1 AND person.name LIKE ?2 ORDER BY person.id DESC LIMIT ?3 OFFSET ?4");
+    }
+
+    SUBCASE(" filters the rows in the database ") {
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(SqlQuery<ClassMock>().equal(&ClassMock::getName, "Ruby"))) == std::vector<int>{2});
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(SqlQuery<ClassMock>().greaterOrEqual(&ClassMock::weight, 70).lessThan(&ClassMock::id, 4))) == std::vector<int>{1, 3});
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(SqlQuery<ClassMock>().in(&ClassMock::id,{2, 3, 5}))) == std::vector<int>{2, 3});
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(SqlQuery<ClassMock>().in(&ClassMock::id,{}))).empty());
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(SqlQuery<ClassMock>().isNull(&ClassMock::getName))) == std::vector<int>{4});
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(SqlQuery<ClassMock>().isNotNull(&ClassMock::getName).notEqual(&ClassMock::id, 1))) == std::vector<int>{2, 3});
+    }
+
+    SUBCASE(" sorts and pages the rows in the database ") {
+        SqlQuery<ClassMock> query;
+        query.like(&ClassMock::getName, "%").orderBy(&ClassMock::getName, SortOrder::Descending);
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(query)) == std::vector<int>{2, 3, 1});
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(query.limit(2))) == std::vector<int>{2, 3});
+        CHECK(idList(SqlRepository<ClassMock>::fetchAll(query.offset(1))) == std::vector<int>{3, 1});
+
+        std::vector<int> streamedIdList;
+        for (const ClassMock& obj : SqlRepository<ClassMock>::stream(SqlQuery<ClassMock>().orderBy(&ClassMock::weight).offset(2)))
+            streamedIdList.push_back(obj.id);
+        CHECK(streamedIdList == std::vector<int>{1, 3});
+    }
+
+    SUBCASE(" aggregates the rows in the database ") {
+        CHECK(SqlRepository<ClassMock>::count() == 4);
+        CHECK(SqlRepository<ClassMock>::count(SqlQuery<ClassMock>().like(&ClassMock::getName, "A%")) == 2);
+        CHECK(SqlRepository<ClassMock>::exists(3));
+        CHECK_FALSE(SqlRepository<ClassMock>::exists(5));
+        CHECK(SqlRepository<ClassMock>::sum(&ClassMock::id) == 10);
+        CHECK(SqlRepository<ClassMock>::sum(&ClassMock::weight, SqlQuery<ClassMock>().lessThan(&ClassMock::id, 3)) > 134.2);
+        CHECK(SqlRepository<ClassMock>::sum(&ClassMock::id, SqlQuery<ClassMock>().greaterThan(&ClassMock::id, 4)) == 0);
+        CHECK(SqlRepository<ClassMock>::min(&ClassMock::id) == 1);
+        CHECK(SqlRepository<ClassMock>::max(&ClassMock::getName) == "Ruby");
+        CHECK(SqlRepository<ClassMock>::max(&ClassMock::id, SqlQuery<ClassMock>().greaterThan(&ClassMock::id, 4)) == 0);
+
+        drv.execute("INSERT INTO person(id, name, weight) values(5, 'Ali', 62)");
+        std::map<std::string, std::size_t> nameCount = SqlRepository<ClassMock>::countBy(&ClassMock::getName, SqlQuery<ClassMock>().isNotNull(&ClassMock::getName));
+        CHECK(nameCount == std::map<std::string, std::size_t>{{"Ali", 2}, {"Amir", 1}, {"Ruby", 1}});
+    }
+
+    SUBCASE(" aggregates only the rows picked by the order and limit of the query ") {
+        CHECK(SqlRepository<ClassMock>::count(SqlQuery<ClassMock>().limit(10)) == 4);
+        CHECK(SqlRepository<ClassMock>::count(SqlQuery<ClassMock>().limit(2)) == 2);
+        CHECK(SqlRepository<ClassMock>::count(SqlQuery<ClassMock>().offset(1)) == 3);
+        CHECK(SqlRepository<ClassMock>::sum(&ClassMock::id, SqlQuery<ClassMock>().orderBy(&ClassMock::weight).limit(2)) == 6);
+        CHECK(SqlRepository<ClassMock>::max(&ClassMock::id, SqlQuery<ClassMock>().orderBy(&ClassMock::weight).offset(3)) == 3);
+
+        drv.execute("INSERT INTO person(id, name, weight) values(5, 'Ali', 62)");
+        std::map<std::string, std::size_t> nameCount = SqlRepository<ClassMock>::countBy(&ClassMock::getName, SqlQuery<ClassMock>().isNotNull(&ClassMock::getName).orderBy(&ClassMock::id, SortOrder::Descending).limit(2));
+        CHECK(nameCount == std::map<std::string, std::size_t>{{"Ali", 1}, {"Amir", 1}});
+    }
+
+    SUBCASE(" throws if the field isn't configured ") {
+        REQUIRE_THROWS_AS(SqlQuery<ClassMock>().equal(&ClassMock::name, "Ali"), Exception);
+    }
+}
+
+TEST_CASE("SqlQuery projection") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table user (id int NOT NULL PRIMARY KEY, name varchar(20))");
+    drv.execute("create table session (id int NOT NULL PRIMARY KEY, time varchar(20), user_id int)");
+    drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+    drv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+    drv.execute("INSERT INTO session(id, time, user_id) values(2, '2018-01-27T01:48:44', 1)");
+
+    SqlEntityConfigurer<UserMock> userConfig;
+    userConfig.setDriver(&drv);
+    userConfig.setTableName("user");
+    userConfig.setPrimaryField("id", &UserMock::id);
+    userConfig.setField("name", &UserMock::name);
+
+    SqlEntityConfigurer<SessionMock> sessionConfig;
+    sessionConfig.setDriver(&drv);
+    sessionConfig.setTableName("session");
+    sessionConfig.setPrimaryField("id", &SessionMock::id);
+    sessionConfig.setField("time", &SessionMock::time);
+
+    SUBCASE(" hydrates only the selected and the primary fields ") {
+        std::vector<SessionMock*> sessionList = SqlRepository<SessionMock>::fetchAll(SqlQuery<SessionMock>().select(&SessionMock::id).orderBy(&SessionMock::id));
+        REQUIRE(sessionList.size() == 2);
+        CHECK(sessionList.at(1)->id == 2);
+        CHECK(sessionList.at(1)->time.empty());
+        for (auto session : sessionList)
+            delete session;
+    }
+
+    SUBCASE(" skips relations unless they are requested ") {
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id");
+
+        std::vector<UserMock*> userList = SqlRepository<UserMock>::fetchAll(SqlQuery<UserMock>().select(&UserMock::name));
+        REQUIRE(userList.size() == 1);
+        CHECK(userList.at(0)->name == "Ali");
+        CHECK(userList.at(0)->sessions.empty());
+        delete userList.at(0);
+
+        userList = SqlRepository<UserMock>::fetchAll(SqlQuery<UserMock>().select(&UserMock::name).withRelations());
+        REQUIRE(userList.size() == 1);
+        CHECK(userList.at(0)->sessions.size() == 2);
+        for (auto session : userList.at(0)->sessions)
+            delete session;
+        delete userList.at(0);
+    }
+
+    SUBCASE(" reads the foreign keys of requested relations ") {
+        sessionConfig.setManyToOneField(&SessionMock::user, "user", "user_id", "id", FetchType::Join);
+
+        int sessionCount = 0;
+        for (const SessionMock& session : SqlRepository<SessionMock>::stream(SqlQuery<SessionMock>().select(&SessionMock::time).withRelations())) {
+            REQUIRE(session.user != nullptr);
+            CHECK(session.user->name == "Ali");
+            CHECK_FALSE(session.time.empty());
+            delete session.user;
+            ++sessionCount;
+        }
+        CHECK(sessionCount == 2);
+    }
+
+    SUBCASE(" streams skip relations unless they are requested ") {
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id");
+        sessionConfig.setManyToOneField(&SessionMock::user, "user", "user_id", "id", FetchType::Join);
+
+        for (const UserMock& user : SqlRepository<UserMock>::stream())
+            CHECK(user.sessions.empty());
+
+        // the instances of the foreign keys belong to the stream.
+        std::vector<int> userIdList;
+        for (const SessionMock& session : SqlRepository<SessionMock>::stream(SqlQuery<SessionMock>().orderBy(&SessionMock::id))) {
+            REQUIRE(session.user != nullptr);
+            CHECK(session.user->name.empty());
+            userIdList.push_back(session.user->id);
+        }
+        CHECK(userIdList == std::vector<int>{1, 1});
+
+        SqlRepository<SessionMock>::Stream stream = SqlRepository<SessionMock>::stream();
+        REQUIRE(stream.begin() != stream.end());
+        CHECK(stream.begin()->user->id == 1);
+    }
+}
@@ -73,6 +73,31 @@ TEST_CASE("SqlRelationOneToManyAttributeImpl") {
         delete user;
     }
 
+    SUBCASE("fetching all entities along with their relations") {
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id");
+
+        drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+        drv.execute("INSERT INTO user(id, name) values(2, 'Ahmad')");
+        drv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+        drv.execute("INSERT INTO session(id, time, user_id) values(2, '2018-01-27T01:48:44', 2)");
+
+        std::vector<UserMock*> userList = SqlRepository<UserMock>::fetchAll();
+
+        REQUIRE(userList.size() == 2);
+        CHECK(userList.at(0)->name == "Ali");
+        REQUIRE(userList.at(0)->sessions.size() == 1);
+        CHECK(userList.at(0)->sessions.at(0)->id == 1);
+        CHECK(userList.at(1)->name == "Ahmad");
+        REQUIRE(userList.at(1)->sessions.size() == 1);
+        CHECK(userList.at(1)->sessions.at(0)->id == 2);
+
+        for (auto user : userList) {
+            for (auto session : user->sessions)
+                delete session;
+            delete user;
+        }
+    }
+
     SUBCASE("persisting entities") {
         UserMock user;
         user.id = 1;
@@ -128,6 +153,21 @@ TEST_CASE("SqlRelationOneToManyAttributeImpl") {
             REQUIRE_FALSE(drv.nextRow());
         }
 
+        SUBCASE(" roll back the entity if saving a cascaded item fails ") {
+            userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id", CascadeType::Persist);
+
+            session2.id = session1.id;
+
+            REQUIRE_THROWS_AS(SqlRepository<UserMock>::persist(&user), Exception);
+            REQUIRE_FALSE(drv.isInTransaction());
+
+            drv.execute("select * from user");
+            REQUIRE_FALSE(drv.nextRow());
+
+            drv.execute("select * from session");
+            REQUIRE_FALSE(drv.nextRow());
+        }
+
         SUBCASE(" update entity in database ") {
             drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
             drv.execute("INSERT INTO session(id, time, user_id) values(1, '2017-01-23T08:54:22', 1)");
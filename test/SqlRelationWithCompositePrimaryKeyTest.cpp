@@ -172,6 +172,137 @@ TEST_CASE(" SqlRelation with composite primary key ") {
                 delete user->getSessions()[1];
                 delete user;
             }
+
+            SUBCASE(" one-to-one relation fetched by a join ") {
+                sessionConfig.setOneToOnePersistentField("user",{
+                    {"user_id", "id"},
+                    {"user_name", "name"}
+                }, &SessionMock::getUser, &SessionMock::setUser, FetchType::Join);
+
+                SessionMock* session = SqlRepository<SessionMock>::fetch(2);
+
+                REQUIRE(session != nullptr);
+                CHECK(session->getTime() == "2018-02-10T05:12:06");
+                REQUIRE(session->getUser() != nullptr);
+                CHECK(session->getUser()->getId() == 1);
+                CHECK(session->getUser()->getName() == "Sami");
+
+                delete session->getUser();
+                delete session;
+
+                std::vector<SessionMock*> sessionList = SqlRepository<SessionMock>::fetchAll();
+
+                REQUIRE(sessionList.size() == 3);
+                CHECK(sessionList.at(0)->getUser()->getName() == "Ali");
+                CHECK(sessionList.at(1)->getUser()->getName() == "Sami");
+                CHECK(sessionList.at(2)->getUser()->getName() == "Ali");
+
+                for (auto s : sessionList) {
+                    delete s->getUser();
+                    delete s;
+                }
+
+                drv.execute("INSERT INTO session(id, time, user_id, user_name) values(4, '2018-04-01T00:00:00', 2, 'Nobody')");
+                REQUIRE_THROWS_AS(SqlRepository<SessionMock>::fetch(4), Exception);
+            }
+
+            SUBCASE(" fetching all entities along with their relations in batches ") {
+
+                SUBCASE(" one-to-one relation ") {
+                    sessionConfig.setOneToOnePersistentField("user",{
+                        {"user_id", "id"},
+                        {"user_name", "name"}
+                    }, &SessionMock::getUser, &SessionMock::setUser);
+
+                    std::vector<SessionMock*> sessionList = SqlRepository<SessionMock>::fetchAll();
+
+                    REQUIRE(sessionList.size() == 3);
+                    CHECK(sessionList.at(0)->getUser()->getName() == "Ali");
+                    CHECK(sessionList.at(1)->getUser()->getName() == "Sami");
+                    CHECK(sessionList.at(2)->getUser()->getName() == "Ali");
+                    CHECK(sessionList.at(0)->getUser() != sessionList.at(2)->getUser());
+
+                    for (auto session : sessionList) {
+                        delete session->getUser();
+                        delete session;
+                    }
+                }
+
+                SUBCASE(" many-to-one relation ") {
+                    userConfig.setOneToOneTransientField("session",{
+                        {"id", "user_id"},
+                        {"name", "user_name"}
+                    }, &UserMock::getSession, &UserMock::setSession);
+
+                    drv.execute("DELETE FROM user WHERE name = 'Omar'");
+
+                    std::vector<UserMock*> userList = SqlRepository<UserMock>::fetchAll();
+
+                    REQUIRE(userList.size() == 2);
+                    CHECK(userList.at(0)->getName() == "Ali");
+                    REQUIRE(userList.at(0)->getSession() != nullptr);
+                    CHECK(userList.at(0)->getSession()->getId() == 1);
+                    CHECK(userList.at(1)->getName() == "Sami");
+                    REQUIRE(userList.at(1)->getSession() != nullptr);
+                    CHECK(userList.at(1)->getSession()->getId() == 2);
+
+                    for (auto user : userList) {
+                        delete user->getSession();
+                        delete user;
+                    }
+                }
+
+                SUBCASE(" one-to-many relation ") {
+                    userConfig.setOneToManyField(&UserMock::getSessions, &UserMock::setSessions, "session",{
+                        {"name", "user_name"},
+                        {"id", "user_id"}
+                    });
+
+                    std::vector<UserMock*> userList = SqlRepository<UserMock>::fetchAll();
+
+                    REQUIRE(userList.size() == 3);
+                    CHECK(userList.at(0)->getName() == "Ali");
+                    REQUIRE(userList.at(0)->getSessions().size() == 2);
+                    CHECK(userList.at(0)->getSessions().at(0)->getId() == 1);
+                    CHECK(userList.at(0)->getSessions().at(1)->getId() == 3);
+                    CHECK(userList.at(1)->getName() == "Sami");
+                    REQUIRE(userList.at(1)->getSessions().size() == 1);
+                    CHECK(userList.at(1)->getSessions().at(0)->getId() == 2);
+                    CHECK(userList.at(2)->getName() == "Omar");
+                    CHECK(userList.at(2)->getSessions().empty());
+
+                    for (auto user : userList) {
+                        for (auto session : user->getSessions())
+                            delete session;
+                        delete user;
+                    }
+                }
+
+                SUBCASE(" many-to-many relation ") {
+                    SqlManyToManyMapping mapping("user", "user_session", "session");
+                    mapping.setLeftMapping("user_id", "id");
+                    mapping.setLeftMapping("user_name", "name");
+                    mapping.setRightMapping("session_id", "id");
+
+                    userConfig.setManyToManyField(mapping, &UserMock::getSessions, &UserMock::setSessions);
+
+                    std::vector<UserMock*> userList = SqlRepository<UserMock>::fetchAll();
+
+                    REQUIRE(userList.size() == 3);
+                    REQUIRE(userList.at(0)->getSessions().size() == 2);
+                    CHECK(userList.at(0)->getSessions().at(0)->getTime() == "2018-01-23T08:54:22");
+                    CHECK(userList.at(0)->getSessions().at(1)->getTime() == "2018-03-11T17:46:52");
+                    REQUIRE(userList.at(1)->getSessions().size() == 1);
+                    CHECK(userList.at(1)->getSessions().at(0)->getId() == 2);
+                    CHECK(userList.at(2)->getSessions().empty());
+
+                    for (auto user : userList) {
+                        for (auto session : user->getSessions())
+                            delete session;
+                        delete user;
+                    }
+                }
+            }
         }
 
         SUBCASE(" persisting entities ") {
@@ -30,6 +30,60 @@
 
 using namespace Salsabil;
 
+namespace {
+
+    struct Reading {
+        long long id;
+        bool isValid;
+        unsigned count;
+        std::vector<unsigned char> payload;
+    };
+
+    struct Appointment {
+        int id;
+        Date day;
+        Time start;
+    };
+
+    struct Event {
+        int id;
+        DateTime at;
+        LocalDateTime local;
+        TimeZone zone;
+    };
+
+    class Note {
+        int mId;
+        std::string mText;
+        std::vector<unsigned char> mAttachment;
+    public:
+
+        int getId() const {
+            return mId;
+        }
+
+        void setId(int id) {
+            mId = id;
+        }
+
+        std::string getText() const {
+            return mText;
+        }
+
+        void setText(std::string&& text) {
+            mText = std::move(text);
+        }
+
+        std::vector<unsigned char> getAttachment() const {
+            return mAttachment;
+        }
+
+        void setAttachment(std::vector<unsigned char> attachment) {
+            mAttachment = std::move(attachment);
+        }
+    };
+}
+
 TEST_CASE("SqlRepository") {
     SqliteDriver drv;
     drv.open(":memory:");
@@ -67,6 +121,23 @@ TEST_CASE("SqlRepository") {
             }
         }
 
+        SUBCASE("ReturnsNothingIfRowWithThatPrimaryKeyNotFound") {
+            conf.setPrimaryField("id", &ClassMock::id);
+            conf.setField("name", &ClassMock::name);
+            drv.execute("INSERT INTO person(id, name) values(2, 'Ruby')");
+
+            CHECK(SqlRepository<ClassMock>::tryFetch(1) == nullptr);
+
+            ClassMock obj;
+            CHECK_FALSE(SqlRepository<ClassMock>::tryFetch({1}, &obj));
+            REQUIRE(SqlRepository<ClassMock>::tryFetch({2}, &obj));
+            CHECK(obj.name == "Ruby");
+
+            std::unique_ptr<ClassMock> fetched(SqlRepository<ClassMock>::tryFetch(2));
+            REQUIRE(fetched != nullptr);
+            CHECK(fetched->name == "Ruby");
+        }
+
         SUBCASE("TestsGetObjectFromDatabase") {
             drv.execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
             drv.execute("INSERT INTO person(id, name, weight) values(2, 'Ruby', 53.8)");
@@ -139,6 +210,43 @@ TEST_CASE("SqlRepository") {
                     delete objList.at(1);
                 }
             }
+
+            SUBCASE("one at a time") {
+                conf.setPrimaryField("id", &ClassMock::id);
+                conf.setField("name", &ClassMock::name);
+                conf.setField("weight", &ClassMock::weight);
+
+                SUBCASE("through stream") {
+                    std::vector<std::string> nameList;
+                    for (const ClassMock& obj : SqlRepository<ClassMock>::stream())
+                        nameList.push_back(obj.name);
+
+                    REQUIRE(nameList.size() == 2);
+                    CHECK(nameList.at(0) == "Ali");
+                    CHECK(nameList.at(1) == "Ruby");
+                }
+
+                SUBCASE("through stream stopped early") {
+                    SqlRepository<ClassMock>::Stream stream = SqlRepository<ClassMock>::stream();
+                    auto it = stream.begin();
+                    REQUIRE(it != stream.end());
+                    CHECK(it->id == 1);
+                    CHECK(stream.begin() == it);
+                }
+
+                SUBCASE("through callback") {
+                    std::vector<const ClassMock*> instanceList;
+                    int idSum = 0;
+                    SqlRepository<ClassMock>::forEach([&](ClassMock & obj) {
+                        instanceList.push_back(&obj);
+                        idSum += obj.id;
+                    });
+
+                    REQUIRE(instanceList.size() == 2);
+                    CHECK(instanceList.at(0) == instanceList.at(1));
+                    CHECK(idSum == 3);
+                }
+            }
         }
 
         SUBCASE("TestsSaveObjectToDatabase") {
@@ -176,6 +284,21 @@ TEST_CASE("SqlRepository") {
                 CHECK(drv.getFloat(2) == 80.5f);
                 REQUIRE(drv.nextRow() == false);
             }
+
+            SUBCASE("without throwing on a taken primary key") {
+                conf.setPrimaryField("id", &ClassMock::id);
+                conf.setField("name", &ClassMock::name);
+
+                CHECK(SqlRepository<ClassMock>::tryPersist(&obj));
+                obj.setName("Ruby");
+                CHECK_FALSE(SqlRepository<ClassMock>::tryPersist(&obj));
+                REQUIRE_THROWS_AS(SqlRepository<ClassMock>::persist(&obj), Exception);
+
+                drv.execute("select name from person");
+                REQUIRE(drv.nextRow() == true);
+                CHECK(drv.getStdString(0) == "Ali");
+                REQUIRE(drv.nextRow() == false);
+            }
         }
     }
 
@@ -192,14 +315,50 @@ TEST_CASE("SqlRepository") {
         conf.setPrimaryField("name", &ClassMock::name);
         conf.setField("weight", &ClassMock::weight);
 
-        ClassMock *obj = SqlRepository<ClassMock>::fetch({2, "Tom"});
+        SUBCASE("fetch by key") {
+            ClassMock *obj = SqlRepository<ClassMock>::fetch({2, "Tom"});
 
-        REQUIRE(obj != nullptr);
-        CHECK(obj->id == 2);
-        CHECK(obj->name == "Tom");
-        CHECK(obj->weight == 12.1f);
+            REQUIRE(obj != nullptr);
+            CHECK(obj->id == 2);
+            CHECK(obj->name == "Tom");
+            CHECK(obj->weight == 12.1f);
 
-        delete obj;
+            delete obj;
+        }
+
+        SUBCASE("fetch pages sought by key") {
+            SqlRepository<ClassMock>::Page page = SqlRepository<ClassMock>::fetchPage(2);
+            REQUIRE(page.entityList.size() == 2);
+            CHECK(page.entityList.at(0)->name == "Ali");
+            CHECK(page.entityList.at(1)->name == "John");
+            CHECK_FALSE(page.isLast());
+            for (auto obj : page.entityList)
+                delete obj;
+
+            // a row inserted before the sought key doesn't shift the following page.
+            drv.execute("INSERT INTO person(id, name, weight) values(0, 'Zaid', 70)");
+
+            page = SqlRepository<ClassMock>::fetchPage(2, page.continuationToken);
+            REQUIRE(page.entityList.size() == 1);
+            CHECK(page.entityList.at(0)->name == "Tom");
+            CHECK(page.isLast());
+            delete page.entityList.at(0);
+
+            REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetchPage(2, "i1:2"), Exception);
+            REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetchPage(2, "i1:xt3:Tom"), Exception);
+            REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetchPage(2, "i99999999999999999999999999:2t3:Tom"), Exception);
+            REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetchPage(2, "i1:2t9:Tom"), Exception);
+            REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetchPage(2, "r5:1e999t3:Tom"), Exception);
+            REQUIRE_THROWS_AS(SqlRepository<ClassMock>::fetchPage(0), Exception);
+        }
+
+        SUBCASE("fetch a page as large as the size type") {
+            SqlRepository<ClassMock>::Page page = SqlRepository<ClassMock>::fetchPage(std::numeric_limits<std::size_t>::max());
+            CHECK(page.entityList.size() == 3);
+            CHECK(page.isLast());
+            for (auto obj : page.entityList)
+                delete obj;
+        }
     }
 
     SUBCASE(" remove object from database ") {
@@ -252,4 +411,297 @@ TEST_CASE("SqlRepository") {
         CHECK(drv.getFloat(2) == 105.5f);
         REQUIRE(drv.nextRow() == false);
     }
-}
\ No newline at end of file
+
+    SUBCASE(" persist, update and remove many entities at once ") {
+        drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+
+        SqlEntityConfigurer<ClassMock> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("person");
+        conf.setPrimaryField("id", &ClassMock::id);
+        conf.setField("name", &ClassMock::name);
+        conf.setField("weight", &ClassMock::weight);
+
+        // more rows than a single multi-row statement holds.
+        const int rowCount = 250;
+        std::vector<ClassMock> objList(rowCount);
+        for (int idx = 0; idx < rowCount; ++idx) {
+            objList[idx].id = idx + 1;
+            objList[idx].name = "name" + std::to_string(idx + 1);
+            objList[idx].weight = idx;
+        }
+
+        SqlRepository<ClassMock>::persistAll(objList);
+
+        drv.execute("select count(*), sum(id) from person");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getInt(0) == rowCount);
+        CHECK(drv.getInt64(1) == static_cast<int64_t> (rowCount) * (rowCount + 1) / 2);
+        REQUIRE_FALSE(drv.nextRow());
+
+        std::vector<ClassMock*> objPointerList;
+        objPointerList.push_back(&objList.front());
+        objPointerList.push_back(&objList.back());
+        objList.front().name = "first";
+        objList.back().name = "last";
+
+        SqlRepository<ClassMock>::updateAll(objPointerList);
+
+        drv.execute("select name from person where id in (1, " + std::to_string(rowCount) + ") order by id");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "first");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "last");
+        REQUIRE_FALSE(drv.nextRow());
+
+        SqlRepository<ClassMock>::removeAll(objPointerList.begin(), objPointerList.end());
+
+        drv.execute("select count(*) from person");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getInt(0) == rowCount - 2);
+        REQUIRE_FALSE(drv.nextRow());
+        CHECK_FALSE(drv.isInTransaction());
+    }
+
+    SUBCASE(" save entities by inserting or updating them ") {
+        drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+        drv.execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
+
+        SqlEntityConfigurer<ClassMock> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("person");
+        conf.setPrimaryField("id", &ClassMock::id);
+        conf.setField("name", &ClassMock::name);
+        conf.setField("weight", &ClassMock::weight);
+
+        ClassMock obj;
+        obj.id = 1;
+        obj.name = "Amir";
+        obj.weight = 91.5;
+        SqlRepository<ClassMock>::save(&obj);
+        obj.id = 2;
+        obj.name = "Ruby";
+        SqlRepository<ClassMock>::save(&obj);
+
+        std::vector<ClassMock> objList(150);
+        for (int idx = 0; idx < 150; ++idx) {
+            objList[idx].id = idx + 2;
+            objList[idx].name = "name" + std::to_string(idx + 2);
+        }
+        SqlRepository<ClassMock>::saveAll(objList);
+
+        drv.execute("select id, name, weight from person where id <= 2 order by id");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(1) == "Amir");
+        CHECK(drv.getDouble(2) == 91.5);
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(1) == "name2");
+        REQUIRE_FALSE(drv.nextRow());
+        CHECK(SqlRepository<ClassMock>::count() == 151);
+        CHECK_FALSE(drv.isInTransaction());
+    }
+
+    SUBCASE(" persist and fetch 64-bit, boolean, unsigned and blob fields ") {
+        drv.execute("create table reading (id integer NOT NULL PRIMARY KEY, valid int, count int, payload blob)");
+
+        SqlEntityConfigurer<Reading> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("reading");
+        conf.setPrimaryField("id", &Reading::id);
+        conf.setField("valid", &Reading::isValid);
+        conf.setField("count", &Reading::count);
+        conf.setField("payload", &Reading::payload);
+
+        Reading reading{(1LL << 40) + 1, true, 4000000000u,
+            {0x00, 0x7F, 0xFF}};
+        SqlRepository<Reading>::persist(&reading);
+        reading.id += 1;
+        reading.isValid = false;
+        reading.payload.clear();
+        SqlRepository<Reading>::persist(&reading);
+
+        std::unique_ptr<Reading> fetched(SqlRepository<Reading>::fetch((1LL << 40) + 1));
+        CHECK(fetched->isValid);
+        CHECK(fetched->count == 4000000000u);
+        CHECK(fetched->payload == std::vector<unsigned char>{0x00, 0x7F, 0xFF});
+
+        SqlRepository<Reading>::Page page = SqlRepository<Reading>::fetchPage(1);
+        REQUIRE(page.entityList.size() == 1);
+        CHECK(page.entityList.at(0)->id == (1LL << 40) + 1);
+        delete page.entityList.at(0);
+
+        page = SqlRepository<Reading>::fetchPage(1, page.continuationToken);
+        REQUIRE(page.entityList.size() == 1);
+        CHECK(page.entityList.at(0)->id == (1LL << 40) + 2);
+        CHECK_FALSE(page.entityList.at(0)->isValid);
+        CHECK(page.entityList.at(0)->payload.empty());
+        CHECK(page.isLast());
+        delete page.entityList.at(0);
+    }
+
+    SUBCASE(" persist and fetch date and time fields as integers ") {
+        drv.execute("create table appointment (id int NOT NULL PRIMARY KEY, day int, start int)");
+
+        SqlEntityConfigurer<Appointment> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("appointment");
+        conf.setPrimaryField("id", &Appointment::id);
+        conf.setField("day", &Appointment::day);
+        conf.setField("start", &Appointment::start);
+
+        Appointment appointment{1, Date(2017, 6, 19), Time(14, 30, 5, 250)};
+        SqlRepository<Appointment>::persist(&appointment);
+        appointment = Appointment{2, Date(1969, 12, 31), Time()};
+        SqlRepository<Appointment>::persist(&appointment);
+
+        drv.execute("select day, start from appointment order by id");
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.getInt64(0) == Date(2017, 6, 19).toDaysSinceEpoch());
+        CHECK(drv.getInt64(1) == Time(14, 30, 5, 250).toNanosecondsSinceMidnight());
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.getInt64(0) == -1);
+        CHECK(drv.isNull(1));
+        REQUIRE(drv.nextRow() == false);
+
+        std::unique_ptr<Appointment> fetched(SqlRepository<Appointment>::fetch(1));
+        CHECK(fetched->day == Date(2017, 6, 19));
+        CHECK(fetched->start == Time(14, 30, 5, 250));
+
+        fetched.reset(SqlRepository<Appointment>::fetch(2));
+        CHECK(fetched->day == Date(1969, 12, 31));
+        CHECK_FALSE(fetched->start.isValid());
+    }
+
+    SUBCASE(" persist and fetch datetime, local datetime and time zone fields ") {
+        drv.execute("create table event (id int NOT NULL PRIMARY KEY, at int, local blob, zone text)");
+
+        SqlEntityConfigurer<Event> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("event");
+        conf.setPrimaryField("id", &Event::id);
+        conf.setField("at", &Event::at);
+        conf.setField("local", &Event::local);
+        conf.setField("zone", &Event::zone);
+
+        // the local times are in the opposite order of the instants they refer to.
+        const DateTime noonInRiyadh(Date(2017, 6, 19), Time(12, 0, 0, 250));
+        const DateTime morningTwoHoursBehindUtc(Date(2017, 6, 19), Time(8, 0, 0));
+        const DateTime beforeEpoch(Date(1969, 12, 31), Time(23, 0, 0));
+
+        Event event{1, noonInRiyadh, LocalDateTime(noonInRiyadh, TimeZone("Asia/Riyadh")), TimeZone("Asia/Riyadh")};
+        SqlRepository<Event>::persist(&event);
+        event = Event{2, morningTwoHoursBehindUtc, LocalDateTime(morningTwoHoursBehindUtc, TimeZone("Etc/GMT+2")), TimeZone("Etc/GMT+2")};
+        SqlRepository<Event>::persist(&event);
+        event = Event{3, beforeEpoch, LocalDateTime(beforeEpoch, TimeZone::utc()), TimeZone()};
+        SqlRepository<Event>::persist(&event);
+        event = Event{4, DateTime(), LocalDateTime(), TimeZone()};
+        SqlRepository<Event>::persist(&event);
+
+        drv.execute("select at, zone from event order by id");
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.getInt64(0) == noonInRiyadh.toNanosecondsSinceEpoch());
+        CHECK(drv.getStdString(1) == "Asia/Riyadh");
+        REQUIRE(drv.nextRow() == true);
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.getInt64(0) < 0);
+        CHECK(drv.isNull(1));
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.isNull(0));
+        CHECK(drv.isNull(1));
+        REQUIRE(drv.nextRow() == false);
+
+        // the blobs of local datetimes sort by the instants they refer to, whatever their zones.
+        drv.execute("select id from event where local is not null order by local");
+        std::vector<int> idList;
+        while (drv.nextRow())
+            idList.push_back(drv.getInt(0));
+        CHECK(idList == std::vector<int>{3, 1, 2});
+
+        std::unique_ptr<Event> fetched(SqlRepository<Event>::fetch(1));
+        CHECK(fetched->at == noonInRiyadh);
+        CHECK(fetched->local.dateTime() == noonInRiyadh);
+        CHECK(fetched->local.timeZone().id() == "Asia/Riyadh");
+        CHECK(fetched->zone.id() == "Asia/Riyadh");
+
+        fetched.reset(SqlRepository<Event>::fetch(2));
+        CHECK(fetched->local.dateTime() == morningTwoHoursBehindUtc);
+        CHECK(fetched->local.timeZone().id() == "Etc/GMT+2");
+        CHECK(fetched->zone == TimeZone("Etc/GMT+2"));
+
+        fetched.reset(SqlRepository<Event>::fetch(3));
+        CHECK(fetched->at == beforeEpoch);
+        CHECK(fetched->local.dateTime() == beforeEpoch);
+        CHECK_FALSE(fetched->zone.isValid());
+
+        fetched.reset(SqlRepository<Event>::fetch(4));
+        CHECK_FALSE(fetched->at.isValid());
+        CHECK_FALSE(fetched->local.isValid());
+        CHECK_FALSE(fetched->zone.isValid());
+    }
+
+    SUBCASE(" hydrate fields through setters taking values or rvalue references ") {
+        drv.execute("create table note (id int NOT NULL PRIMARY KEY, text text, attachment blob)");
+
+        SqlEntityConfigurer<Note> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("note");
+        conf.setPrimaryField("id", &Note::getId, &Note::setId);
+        conf.setField("text", &Note::getText, &Note::setText);
+        conf.setField("attachment", &Note::getAttachment, &Note::setAttachment);
+
+        Note note;
+        note.setId(1);
+        note.setText("remember the milk");
+        note.setAttachment({0x01, 0x02});
+        SqlRepository<Note>::persist(&note);
+
+        std::unique_ptr<Note> fetched(SqlRepository<Note>::fetch(1));
+        CHECK(fetched->getText() == "remember the milk");
+        CHECK(fetched->getAttachment() == std::vector<unsigned char>{0x01, 0x02});
+
+        AccessWrapperMethodImpl<Note, std::string, std::string(Note::*)() const, void(Note::*)(std::string&&)> textWrapper(&Note::getText, &Note::setText);
+        std::string text = "buy bread";
+        textWrapper.set(&note, &text);
+        CHECK(note.getText() == "buy bread");
+        CHECK(text == "buy bread");
+
+        AccessWrapperMethodImpl<Note, std::vector<unsigned char>, std::vector<unsigned char>(Note::*)() const, void(Note::*)(std::vector<unsigned char>)> attachmentWrapper(&Note::getAttachment, &Note::setAttachment);
+        std::vector<unsigned char> attachment{0x03};
+        attachmentWrapper.move(&note, &attachment);
+        CHECK(note.getAttachment() == std::vector<unsigned char>{0x03});
+        CHECK(attachment.empty());
+    }
+
+    SUBCASE(" bind values instead of inlining them into statements ") {
+        drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+
+        SqlEntityConfigurer<ClassMock> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("person");
+        conf.setPrimaryField("id", &ClassMock::id);
+        conf.setField("name", &ClassMock::name);
+        conf.setField("weight", &ClassMock::weight);
+
+        ClassMock obj;
+        obj.id = 1;
+        obj.name = "O'Neil";
+        obj.weight = 80.5f;
+        SqlRepository<ClassMock>::persist(&obj);
+
+        obj.id = 2;
+        obj.name = "Ruby";
+        SqlRepository<ClassMock>::persist(&obj);
+
+        std::size_t missCount = drv.statementCacheMissCount();
+
+        ClassMock *first = SqlRepository<ClassMock>::fetch(1);
+        ClassMock *second = SqlRepository<ClassMock>::fetch(2);
+
+        CHECK(first->name == "O'Neil");
+        CHECK(second->name == "Ruby");
+        CHECK(drv.statementCacheMissCount() == missCount + 1);
+
+        delete first;
+        delete second;
+    }
+}
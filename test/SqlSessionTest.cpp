@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "mocks/ClassMock.hpp"
+#include "mocks/UserMock.hpp"
+#include "mocks/SessionMock.hpp"
+#include "Exception.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlSession.hpp"
+
+using namespace Salsabil;
+
+namespace {
+
+    // counts the statements it runs, including those beginning and ending transactions.
+    class StatementCountingDriver : public SqliteDriver {
+    public:
+        using SqliteDriver::execute;
+
+        StatementCountingDriver() : statementCount(0) {
+        }
+
+        virtual SqlStatement* createStatement(const std::string& sqlStatement) {
+            ++statementCount;
+            return SqliteDriver::createStatement(sqlStatement);
+        }
+
+        virtual void execute(const std::string& sqlStatement) {
+            ++statementCount;
+            SqliteDriver::execute(sqlStatement);
+        }
+
+        int statementCount;
+    };
+}
+
+TEST_CASE("SqlSession") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+    drv.execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
+    drv.execute("INSERT INTO person(id, name, weight) values(2, 'Ruby', 53.8)");
+
+    SqlEntityConfigurer<ClassMock> conf;
+    conf.setDriver(&drv);
+    conf.setTableName("person");
+    conf.setPrimaryField("id", &ClassMock::id);
+    conf.setField("name", &ClassMock::name);
+    conf.setField("weight", &ClassMock::weight);
+
+    SqlSession session;
+
+    SUBCASE(" fetches each row only once ") {
+        ClassMock* obj = session.fetch<ClassMock>(1);
+        REQUIRE(obj != nullptr);
+        CHECK(obj->name == "Ali");
+        CHECK(session.contains<ClassMock>(1));
+        CHECK_FALSE(session.contains<ClassMock>(2));
+
+        // the row is changed behind the session's back, yet the held instance is returned.
+        drv.execute("UPDATE person SET name = 'Omar' WHERE id = 1");
+        CHECK(session.fetch<ClassMock>(1) == obj);
+        CHECK(obj->name == "Ali");
+        CHECK(session.size() == 1);
+    }
+
+    SUBCASE(" represents rows by held instances when fetching all ") {
+        ClassMock* obj = session.fetch<ClassMock>(2);
+
+        std::vector<ClassMock*> objList = session.fetchAll<ClassMock>();
+        REQUIRE(objList.size() == 2);
+        CHECK(objList.at(0)->name == "Ali");
+        CHECK(objList.at(1) == obj);
+        CHECK(session.fetch<ClassMock>(1) == objList.at(0));
+        CHECK(session.size() == 2);
+
+        session.clear();
+        CHECK(session.size() == 0);
+        CHECK_FALSE(session.contains<ClassMock>(1));
+    }
+
+    SUBCASE(" gives evicted instances to the caller ") {
+        ClassMock* obj = session.fetch<ClassMock>(1);
+        session.evict(obj);
+        CHECK_FALSE(session.contains<ClassMock>(1));
+
+        ClassMock* refetchedObj = session.fetch<ClassMock>(1);
+        CHECK(refetchedObj != obj);
+        delete obj;
+    }
+
+    SUBCASE(" updates only the changed columns of tracked instances ") {
+        CHECK(session.isTrackingChanges());
+        ClassMock* obj = session.fetch<ClassMock>(1);
+
+        // the columns written by an update overwrite the row, the others are left as they are.
+        drv.execute("UPDATE person SET name = 'Omar', weight = 60 WHERE id = 1");
+        CHECK_FALSE(session.update(obj));
+        obj->weight = 81.5;
+        CHECK(session.update(obj));
+        CHECK_FALSE(session.update(obj));
+
+        drv.execute("select name, weight from person where id = 1");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "Omar");
+        CHECK(drv.getDouble(1) == 81.5);
+
+        session.setChangeTracking(false);
+        ClassMock* untrackedObj = session.fetch<ClassMock>(2);
+        CHECK(session.update(untrackedObj));
+    }
+
+    SUBCASE(" executes no statement for an unchanged tracked instance whose relations don't cascade updates ") {
+        StatementCountingDriver countingDrv;
+        countingDrv.open(":memory:");
+        countingDrv.execute("create table user (id int NOT NULL PRIMARY KEY, name varchar(20))");
+        countingDrv.execute("create table session (id int NOT NULL PRIMARY KEY, time varchar(20), user_id int)");
+        countingDrv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+        countingDrv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+
+        SqlEntityConfigurer<SessionMock> sessionConfig;
+        sessionConfig.setDriver(&countingDrv);
+        sessionConfig.setTableName("session");
+        sessionConfig.setPrimaryField("id", &SessionMock::id);
+        sessionConfig.setField("time", &SessionMock::time);
+
+        SqlEntityConfigurer<UserMock> userConfig;
+        userConfig.setDriver(&countingDrv);
+        userConfig.setTableName("user");
+        userConfig.setPrimaryField("id", &UserMock::id);
+        userConfig.setField("name", &UserMock::name);
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id", CascadeType::Persist);
+
+        UserMock* user = session.fetch<UserMock>(1);
+        REQUIRE(user->sessions.size() == 1);
+
+        countingDrv.statementCount = 0;
+        CHECK_FALSE(session.update(user));
+        CHECK(countingDrv.statementCount == 0);
+
+        user->name = "Omar";
+        CHECK(session.update(user));
+        CHECK(countingDrv.statementCount > 0);
+
+        delete user->sessions.at(0);
+    }
+
+    SUBCASE(" updates the cascaded relations of unchanged tracked instances ") {
+        drv.execute("create table user (id int NOT NULL PRIMARY KEY, name varchar(20))");
+        drv.execute("create table session (id int NOT NULL PRIMARY KEY, time varchar(20), user_id int)");
+        drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+        drv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+
+        SqlEntityConfigurer<SessionMock> sessionConfig;
+        sessionConfig.setDriver(&drv);
+        sessionConfig.setTableName("session");
+        sessionConfig.setPrimaryField("id", &SessionMock::id);
+        sessionConfig.setField("time", &SessionMock::time);
+
+        SqlEntityConfigurer<UserMock> userConfig;
+        userConfig.setDriver(&drv);
+        userConfig.setTableName("user");
+        userConfig.setPrimaryField("id", &UserMock::id);
+        userConfig.setField("name", &UserMock::name);
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id", CascadeType::Update);
+
+        UserMock* user = session.fetch<UserMock>(1);
+        REQUIRE(user->sessions.size() == 1);
+
+        // the unchanged row of the owner isn't written, whereas the relation cascading updates is.
+        drv.execute("UPDATE user SET name = 'Zaid' WHERE id = 1");
+        user->sessions.at(0)->time = "2019-02-24T09:55:23";
+        CHECK_FALSE(session.update(user));
+
+        drv.execute("select time from session where id = 1");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "2019-02-24T09:55:23");
+        drv.execute("select name from user where id = 1");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "Zaid");
+
+        delete user->sessions.at(0);
+    }
+
+    SUBCASE(" hydrates only the rows it doesn't hold when fetching all ") {
+        drv.execute("create table user (id int NOT NULL PRIMARY KEY, name varchar(20))");
+        drv.execute("create table session (id int NOT NULL PRIMARY KEY, time varchar(20), user_id int)");
+        drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+        drv.execute("INSERT INTO user(id, name) values(2, 'Omar')");
+        drv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+        drv.execute("INSERT INTO session(id, time, user_id) values(2, '2018-01-27T01:48:44', 2)");
+
+        SqlEntityConfigurer<SessionMock> sessionConfig;
+        sessionConfig.setDriver(&drv);
+        sessionConfig.setTableName("session");
+        sessionConfig.setPrimaryField("id", &SessionMock::id);
+        sessionConfig.setField("time", &SessionMock::time);
+
+        SqlEntityConfigurer<UserMock> userConfig;
+        userConfig.setDriver(&drv);
+        userConfig.setTableName("user");
+        userConfig.setPrimaryField("id", &UserMock::id);
+        userConfig.setField("name", &UserMock::name);
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id");
+
+        UserMock* user = session.fetch<UserMock>(1);
+        REQUIRE(user->sessions.size() == 1);
+        SessionMock* userSession = user->sessions.at(0);
+
+        // the held row is changed behind the session's back, yet neither it nor its relations are read again.
+        drv.execute("UPDATE user SET name = 'Zaid' WHERE id = 1");
+        std::vector<UserMock*> userList = session.fetchAll<UserMock>();
+        REQUIRE(userList.size() == 2);
+        CHECK(userList.at(0) == user);
+        CHECK(user->name == "Ali");
+        REQUIRE(user->sessions.size() == 1);
+        CHECK(user->sessions.at(0) == userSession);
+        CHECK(userList.at(1)->name == "Omar");
+        REQUIRE(userList.at(1)->sessions.size() == 1);
+        CHECK(userList.at(1)->sessions.at(0)->time == "2018-01-27T01:48:44");
+
+        delete userSession;
+        delete userList.at(1)->sessions.at(0);
+    }
+
+    SUBCASE(" doesn't hold the instances read through relations ") {
+        drv.execute("create table user (id int NOT NULL PRIMARY KEY, name varchar(20))");
+        drv.execute("create table session (id int NOT NULL PRIMARY KEY, time varchar(20), user_id int)");
+        drv.execute("INSERT INTO user(id, name) values(1, 'Ali')");
+        drv.execute("INSERT INTO session(id, time, user_id) values(1, '2018-01-23T08:54:22', 1)");
+
+        SqlEntityConfigurer<SessionMock> sessionConfig;
+        sessionConfig.setDriver(&drv);
+        sessionConfig.setTableName("session");
+        sessionConfig.setPrimaryField("id", &SessionMock::id);
+        sessionConfig.setField("time", &SessionMock::time);
+
+        SqlEntityConfigurer<UserMock> userConfig;
+        userConfig.setDriver(&drv);
+        userConfig.setTableName("user");
+        userConfig.setPrimaryField("id", &UserMock::id);
+        userConfig.setField("name", &UserMock::name);
+        userConfig.setOneToManyField(&UserMock::sessions, "session", "user_id");
+
+        UserMock* user = session.fetch<UserMock>(1);
+        REQUIRE(user->sessions.size() == 1);
+        CHECK_FALSE(session.contains<SessionMock>(1));
+        CHECK(session.fetch<SessionMock>(1) != user->sessions.at(0));
+        CHECK(session.size() == 2);
+
+        delete user->sessions.at(0);
+    }
+
+    SUBCASE(" throws if the row doesn't exist ") {
+        REQUIRE_THROWS_AS(session.fetch<ClassMock>(3), Exception);
+        CHECK(session.size() == 0);
+    }
+}
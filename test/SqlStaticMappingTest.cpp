@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "mocks/ClassMock.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlEntityConfigurer.hpp"
+#include "SqlRepository.hpp"
+#include "SqlStaticMapping.hpp"
+
+using namespace Salsabil;
+
+TEST_CASE("SqlStaticMapping") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("create table person (id int NOT NULL PRIMARY KEY, name varchar(20), weight float)");
+
+    SUBCASE(" map columns to attributes ") {
+        const auto mapping = makeSqlStaticMapping<ClassMock>("person",
+                sqlColumn("id", &ClassMock::id),
+                sqlColumn("name", &ClassMock::name),
+                sqlColumn("weight", &ClassMock::weight));
+
+        CHECK(mapping.tableName() == "person");
+        CHECK(mapping.columnNameList() == std::vector<std::string>{"id", "name", "weight"});
+
+        const std::uint64_t version = SqlQueryCache::tableVersion("person");
+        std::vector<ClassMock> objList(2);
+        objList[0].id = 1;
+        objList[0].name = "Ali";
+        objList[0].weight = 80.5f;
+        objList[1].id = 2;
+        objList[1].name = "O'Neil";
+        objList[1].weight = 70.25f;
+        mapping.persistAll(&drv, objList);
+        CHECK(SqlQueryCache::tableVersion("person") > version);
+
+        drv.execute("select id, name, weight from person order by id");
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.getInt(0) == 1);
+        CHECK(drv.getStdString(1) == "Ali");
+        CHECK(drv.getFloat(2) == 80.5f);
+        REQUIRE(drv.nextRow() == true);
+        CHECK(drv.getStdString(1) == "O'Neil");
+        REQUIRE(drv.nextRow() == false);
+
+        std::vector<ClassMock> fetchedList = mapping.fetchAll(&drv);
+        REQUIRE(fetchedList.size() == 2);
+        CHECK(fetchedList[1].id == 2);
+        CHECK(fetchedList[1].name == "O'Neil");
+        CHECK(fetchedList[1].weight == 70.25f);
+
+        fetchedList = mapping.fetchAll(&drv, "weight > ? AND name LIKE ?",{75, "A%"});
+        REQUIRE(fetchedList.size() == 1);
+        CHECK(fetchedList[0].id == 1);
+    }
+
+    SUBCASE(" map columns to getters and setters ") {
+        drv.execute("INSERT INTO person(id, name, weight) values(1, 'Ali', 80.5)");
+
+        const auto mapping = makeSqlStaticMapping<ClassMock>("person",
+                sqlColumn("id", &ClassMock::getId, &ClassMock::setId),
+                sqlColumn("name", &ClassMock::getName, &ClassMock::setName),
+                sqlColumn("weight", &ClassMock::getWeight, &ClassMock::setWeight));
+
+        std::vector<ClassMock> fetchedList = mapping.fetchAll(&drv);
+        REQUIRE(fetchedList.size() == 1);
+        CHECK(fetchedList[0].getName() == "Ali");
+
+        fetchedList[0].setId(2);
+        fetchedList[0].setName("Ruby");
+        mapping.persistAll(&drv, fetchedList);
+        CHECK(mapping.fetchAll(&drv, "id = ?",{2}).at(0).getName() == "Ruby");
+    }
+
+    SUBCASE(" read and bind rows like the configured fields ") {
+        SqlEntityConfigurer<ClassMock> conf;
+        conf.setDriver(&drv);
+        conf.setTableName("person");
+        conf.setPrimaryField("id", &ClassMock::id);
+        conf.setField("name", &ClassMock::name);
+        conf.setField("weight", &ClassMock::weight);
+
+        ClassMock obj;
+        obj.id = 7;
+        obj.name = "Ali";
+        obj.weight = 80.5f;
+        SqlRepository<ClassMock>::persist(&obj);
+
+        const auto mapping = makeSqlStaticMapping<ClassMock>("person",
+                sqlColumn("weight", &ClassMock::weight),
+                sqlColumn("id", &ClassMock::id),
+                sqlColumn("name", &ClassMock::name));
+
+        std::unique_ptr<SqlStatement> statement(drv.createStatement("select 0, weight, id, name from person"));
+        statement->execute();
+        REQUIRE(statement->nextRow());
+        ClassMock fetched;
+        mapping.readRow(statement.get(), &fetched, 1);
+        CHECK(fetched.id == 7);
+        CHECK(fetched.name == "Ali");
+        CHECK(fetched.weight == 80.5f);
+
+        statement.reset(drv.createStatement("update person set name = ? where weight = ? and id = ? and name = ?"));
+        statement->bindStdString(1, "Ruby");
+        CHECK(mapping.bindRow(statement.get(), &fetched, 2) == 5);
+        statement->execute();
+
+        std::unique_ptr<ClassMock> updated(SqlRepository<ClassMock>::fetch(7));
+        CHECK(updated->name == "Ruby");
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "Exception.hpp"
+#include "SqliteDriver.hpp"
+#include "SqlTransaction.hpp"
+
+using namespace Salsabil;
+
+namespace {
+
+    int rowCount(SqliteDriver& drv) {
+        drv.execute("SELECT count(*) FROM tbl");
+        drv.nextRow();
+        int count = drv.getInt(0);
+        drv.nextRow();
+        return count;
+    }
+}
+
+TEST_CASE("SqlTransaction") {
+    SqliteDriver drv;
+    drv.open(":memory:");
+    drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+
+    SUBCASE("CommitsChanges") {
+        SqlTransaction transaction(&drv);
+        REQUIRE(drv.isInTransaction());
+        REQUIRE_FALSE(transaction.isSavepoint());
+
+        drv.execute("INSERT INTO tbl VALUES(1, 'abc')");
+        transaction.commit();
+
+        CHECK_FALSE(transaction.isActive());
+        CHECK_FALSE(drv.isInTransaction());
+        CHECK(rowCount(drv) == 1);
+    }
+
+    SUBCASE("RollsBackChangesIfNotCommitted") {
+        {
+            SqlTransaction transaction(&drv);
+            drv.execute("INSERT INTO tbl VALUES(1, 'abc')");
+            CHECK(rowCount(drv) == 1);
+        }
+
+        CHECK_FALSE(drv.isInTransaction());
+        CHECK(rowCount(drv) == 0);
+    }
+
+    SUBCASE("ThrowsIfFinishedTwice") {
+        SqlTransaction transaction(&drv);
+        transaction.rollback();
+
+        REQUIRE_THROWS_AS(transaction.commit(), Exception);
+        REQUIRE_THROWS_AS(transaction.rollback(), Exception);
+    }
+
+    SUBCASE("UsesSavepointsForNestedTransactions") {
+        SqlTransaction outer(&drv);
+        drv.execute("INSERT INTO tbl VALUES(1, 'abc')");
+
+        {
+            SqlTransaction inner(&drv);
+            REQUIRE(inner.isSavepoint());
+            drv.execute("INSERT INTO tbl VALUES(2, 'cde')");
+        }
+
+        CHECK(drv.isInTransaction());
+        CHECK(rowCount(drv) == 1);
+
+        {
+            SqlTransaction inner(&drv);
+            drv.execute("INSERT INTO tbl VALUES(3, 'efg')");
+            inner.commit();
+        }
+
+        CHECK(drv.isInTransaction());
+        outer.commit();
+
+        CHECK_FALSE(drv.isInTransaction());
+        CHECK(rowCount(drv) == 2);
+    }
+
+    SUBCASE("CallsTransactionEndListenersOnceTheOutermostTransactionEnds") {
+        int callCount = 0;
+        auto listener = [&callCount](SqlDriver*) {
+            ++callCount;
+        };
+
+        SqlTransaction outer(&drv);
+        drv.onTransactionEnd(&callCount, listener);
+        {
+            SqlTransaction inner(&drv);
+            drv.onTransactionEnd(&callCount, listener);
+            inner.commit();
+        }
+        CHECK(callCount == 0);
+        outer.commit();
+        CHECK(callCount == 1);
+
+        drv.beginTransaction();
+        drv.onTransactionEnd(&callCount, listener);
+        drv.rollback();
+        CHECK(callCount == 2);
+
+        drv.beginTransaction();
+        drv.commit();
+        CHECK(callCount == 2);
+    }
+}
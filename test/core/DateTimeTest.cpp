@@ -62,6 +62,13 @@ TEST_CASE("DateTimeTest") {
         CHECK(DateTime::epoch() == DateTime(Date(1970, 1, 1), Time(0, 0, 0)));
     }
 
+    SUBCASE("ConstructsFromDurationBeforeEpoch") {
+        DateTime dt(-DateTime::Hours(1) - DateTime::Nanoseconds(1));
+        CHECK(dt.isValid());
+        CHECK(dt == DateTime(Date(1969, 12, 31), Time(22, 59, 59, Time::Nanoseconds(999999999))));
+        CHECK(dt.toNanosecondsSinceEpoch() == -3600000000001LL);
+    }
+
     SUBCASE("ConstructsFromDateAndTime") {
         DateTime dt(Date(1999, 12, 1), Time(8, 55, 21, Time::Nanoseconds(123456789)));
         CHECK(dt.year() == 1999);
@@ -79,4 +79,54 @@ TEST_CASE("SqlGenerator") {
             { "name", "'Omar'"}
         }) == "DELETE FROM user WHERE id = 1 AND name = 'Omar'");
     }
-}
\ No newline at end of file
+
+    SUBCASE(" fetch a specific row from a table with placeholders ") {
+        CHECK(SqlGenerator::preparedFetchById("user",{"no", "name"}) == "SELECT * FROM user WHERE no = ?1 AND name = ?2");
+    }
+
+    SUBCASE(" insert a row into a table with placeholders ") {
+        CHECK(SqlGenerator::preparedInsert("user",{"id", "name"}) == "INSERT INTO user(id, name) VALUES(?1, ?2)");
+        CHECK(SqlGenerator::preparedInsert("user",{"id", "name"}, 3) == "INSERT INTO user(id, name) VALUES(?1, ?2), (?3, ?4), (?5, ?6)");
+    }
+
+    SUBCASE(" insert or update rows with placeholders ") {
+        CHECK(SqlGenerator::preparedUpsert("user",{"id", "name", "age"},{"id"}) == "INSERT INTO user(id, name, age) VALUES(?1, ?2, ?3) ON CONFLICT(id) DO UPDATE SET name = excluded.name, age = excluded.age");
+        CHECK(SqlGenerator::preparedUpsert("user",{"id", "name"},{"id"}, 2) == "INSERT INTO user(id, name) VALUES(?1, ?2), (?3, ?4) ON CONFLICT(id) DO UPDATE SET name = excluded.name");
+        CHECK(SqlGenerator::preparedUpsert("user",{"id", "no"},{"id", "no"}) == "INSERT INTO user(id, no) VALUES(?1, ?2) ON CONFLICT(id, no) DO NOTHING");
+    }
+
+    SUBCASE(" match columns against a list of rows with placeholders ") {
+        CHECK(SqlGenerator::preparedIn({"id"}, 3) == "id IN (?1, ?2, ?3)");
+        CHECK(SqlGenerator::preparedIn({"id", "name"}, 2) == "(id, name) IN (VALUES(?1, ?2), (?3, ?4))");
+        CHECK(SqlGenerator::preparedIn({"id"}, 2, 4) == "id IN (?4, ?5)");
+    }
+
+    SUBCASE(" aggregate the rows of a table ") {
+        CHECK(SqlGenerator::aggregate("user", "COUNT", "*") == "SELECT COUNT(*) FROM user");
+        CHECK(SqlGenerator::aggregate("user", "COUNT", "*", "user.age") == "SELECT user.age, COUNT(*) FROM user");
+        CHECK(SqlGenerator::preparedExists("user",{"id", "no"}) == "SELECT 1 FROM user WHERE id = ?1 AND no = ?2 LIMIT 1");
+        CHECK(SqlGenerator::preparedSelect("SELECT age, COUNT(*) FROM user",{"name LIKE ?1"},{}, 0,{"age"}) == "SELECT age, COUNT(*) FROM user WHERE name LIKE ?1 GROUP BY age");
+    }
+
+    SUBCASE(" seek the rows after a key with placeholders ") {
+        CHECK(SqlGenerator::preparedSeek({"id"}) == "id > ?1");
+        CHECK(SqlGenerator::preparedSeek({"id", "no"}, 2) == "(id, no) > (?2, ?3)");
+    }
+
+    SUBCASE(" filter, sort and limit a query with placeholders ") {
+        CHECK(SqlGenerator::preparedSelect("SELECT * FROM user",{},{}) == "SELECT * FROM user");
+        CHECK(SqlGenerator::preparedSelect("SELECT * FROM user",{"age > ?1", "name LIKE ?2"},{"name DESC", "id ASC"}, 3) ==
+                "SELECT * FROM user WHERE age > ?1 AND name LIKE ?2 ORDER BY name DESC, id ASC LIMIT ?3 OFFSET ?4");
+    }
+
+    SUBCASE(" update a row in a table with placeholders ") {
+        CHECK(SqlGenerator::preparedUpdate("user",{"name", "weight"},
+        {
+            "id", "no"
+        }) == "UPDATE user SET name = ?1, weight = ?2 WHERE id = ?3 AND no = ?4");
+    }
+
+    SUBCASE(" remove a row from a table with placeholders ") {
+        CHECK(SqlGenerator::preparedRemove("user",{"id", "name"}) == "DELETE FROM user WHERE id = ?1 AND name = ?2");
+    }
+}
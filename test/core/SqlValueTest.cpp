@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017-2018, Abdullatif Kalla. All rights reserved.
+ * E-mail: laateef@outlook.com
+ * Github: https://github.com/Laateef/Salsabil
+ *
+ * This file is part of the Salsabil project.
+ * 
+ * Salsabil is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * Salsabil is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the 
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with Salsabil. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "doctest.h"
+#include "internal/SqlValue.hpp"
+#include "internal/SqlBindingRecorder.hpp"
+#include "internal/TypeResolver.hpp"
+#include "Exception.hpp"
+
+#include <limits>
+
+using namespace Salsabil;
+
+TEST_CASE("SqlValue") {
+
+    SUBCASE(" holds values natively ") {
+        CHECK(SqlValue().isNull());
+        CHECK(SqlValue(nullptr).isNull());
+        CHECK(SqlValue(static_cast<const char*> (nullptr)).isNull());
+        CHECK(SqlValue(true).toInt64() == 1);
+        CHECK(SqlValue(4000000000u).toInt64() == 4000000000LL);
+        CHECK(SqlValue(std::numeric_limits<long long>::max()).toInt64() == std::numeric_limits<long long>::max());
+        CHECK(SqlValue(0.1).toDouble() == 0.1);
+        CHECK(SqlValue(2.5f).type() == SqlValue::Type::Real);
+        CHECK(SqlValue("Ali").text() == "Ali");
+        CHECK(SqlValue(std::vector<unsigned char>{0x00, 0xFF}).text() == std::string("\0\xFF", 2));
+    }
+
+    SUBCASE(" formats values as SQL literals ") {
+        CHECK(SqlValue().toString() == "NULL");
+        CHECK(SqlValue(-42).toString() == "-42");
+        CHECK(SqlValue(80.5).toString() == "80.5");
+        CHECK(SqlValue("Ali").toString() == "'Ali'");
+        CHECK(SqlValue::blob("\x0A\xBC", 2).toString() == "X'0ABC'");
+    }
+
+    SUBCASE(" compares by type and value ") {
+        CHECK(SqlValue(1) == SqlValue(1LL));
+        CHECK(SqlValue(1) != SqlValue(1.0));
+        CHECK(SqlValue("1") != SqlValue(1));
+        CHECK(SqlValue("ab") != SqlValue::blob("ab", 2));
+        CHECK(SqlValue() == SqlValue(nullptr));
+    }
+
+    SUBCASE(" copies and moves the bytes it holds ") {
+        SqlValue text(std::string(100, 'x'));
+        SqlValue copy(text);
+        SqlValue moved(std::move(text));
+        CHECK(copy == moved);
+        copy = SqlValue(3);
+        CHECK(copy.toInt64() == 3);
+        moved = copy;
+        CHECK(moved == SqlValue(3));
+    }
+
+    SUBCASE(" binds values without formatting them ") {
+        SqlBindingRecorder recorder;
+        SqlValue(std::numeric_limits<long long>::min()).bindTo(&recorder, 1);
+        SqlValue(0.1).bindTo(&recorder, 2);
+        SqlValue::blob("\0\1", 2).bindTo(&recorder, 3);
+        SqlValue().bindTo(&recorder, 4);
+        CHECK(recorder.bindingMap().at(1).toInt64() == std::numeric_limits<long long>::min());
+        CHECK(recorder.bindingMap().at(2).toDouble() == 0.1);
+        CHECK(recorder.bindingMap().at(3).type() == SqlValue::Type::Blob);
+        CHECK(recorder.bindingMap().at(3).text().size() == 2);
+        CHECK(recorder.bindingMap().at(4).isNull());
+    }
+
+    SUBCASE(" holds unsigned 64-bit values within the range of signed ones ") {
+        const unsigned long long maxValue = std::numeric_limits<std::int64_t>::max();
+        CHECK(SqlValue(std::size_t(42)).toInt64() == 42);
+        CHECK(SqlValue(std::uint64_t(maxValue)).toInt64() == std::numeric_limits<std::int64_t>::max());
+        CHECK(SqlValue(42ul) == SqlValue(42));
+        REQUIRE_THROWS_AS(SqlValue(maxValue + 1), Exception);
+        REQUIRE_THROWS_AS(SqlValue(std::numeric_limits<unsigned long>::max()), Exception);
+
+        SqlBindingRecorder recorder;
+        std::size_t id = 7;
+        unsigned long long largeId = maxValue + 1;
+        Utility::variableToStatement(&recorder, 1, &id);
+        CHECK(recorder.bindingMap().at(1).toInt64() == 7);
+        REQUIRE_THROWS_AS(Utility::variableToStatement(&recorder, 2, &largeId), Exception);
+    }
+}
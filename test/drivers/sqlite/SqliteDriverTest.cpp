@@ -24,6 +24,7 @@
 #include "Exception.hpp"
 #include <cstring>
 #include <algorithm>
+#include <memory>
 
 using namespace Salsabil;
 
@@ -56,6 +57,24 @@ TEST_CASE("SqliteDriver") {
         REQUIRE_THROWS_AS(drv.execute(), Exception);
     }
 
+    SUBCASE("ReportsConstraintViolationsWithoutThrowing") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY NOT NULL, name TEXT)");
+        std::unique_ptr<SqlStatement> statement(drv.createStatement("INSERT INTO tbl VALUES(?1, 'abc')"));
+        statement->bindInt(1, 1);
+        CHECK(statement->tryExecute());
+        statement->reset();
+        statement->bindInt(1, 1);
+        CHECK_FALSE(statement->tryExecute());
+        CHECK_FALSE(statement->nextRow());
+        statement->reset();
+        statement->bindNull(1);
+        CHECK_FALSE(statement->tryExecute());
+
+        // abs() overflows on the least integer, which fails at run time.
+        std::unique_ptr<SqlStatement> invalidStatement(drv.createStatement("INSERT INTO tbl VALUES(abs(-9223372036854775808), 'abc')"));
+        REQUIRE_THROWS_AS(invalidStatement->tryExecute(), Exception);
+    }
+
     SUBCASE("ThrowsIfAskedToFetchRowForNonQuerySqlStatements") {
         drv.prepare("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
         drv.execute();
@@ -130,6 +149,36 @@ TEST_CASE("SqliteDriver") {
         REQUIRE(memcmp(drv.getBlob(2), expect, sizeof (expect)) == 0);
     }
 
+    SUBCASE("FetchStringViewAndBlobSpanResult") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, str TEXT, b BLOB, n TEXT)");
+        drv.execute("INSERT INTO tbl VALUES(1, 'Hi' || char(0) || 'there', X'53514C697465', NULL)");
+        drv.execute("SELECT * FROM tbl");
+
+        SqlStringView view = drv.getStringView(1);
+        REQUIRE(view.size == 8u);
+        REQUIRE(std::string(view.data, view.size) == std::string("Hi\0there", 8));
+        REQUIRE(drv.getStdString(1).size() == 8u);
+
+        SqlBlobSpan span = drv.getBlobSpan(2);
+        REQUIRE(span.size == 6u);
+        const char expect[] = {0x53, 0x51, 0x4C, 0x69, 0x74, 0x65};
+        REQUIRE(memcmp(span.data, expect, sizeof (expect)) == 0);
+
+        REQUIRE(drv.getStringView(3).data == nullptr);
+        REQUIRE(drv.getStdString(3).empty());
+    }
+
+    SUBCASE("BindsStringsWithEmbeddedNulls") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, str TEXT)");
+        drv.prepare("INSERT INTO tbl VALUES(1, ?)");
+        drv.bindStdString(1, std::string("Hi\0there", 8));
+        drv.execute();
+
+        drv.execute("SELECT str FROM tbl");
+        REQUIRE(drv.nextRow());
+        REQUIRE(drv.getStdString(0) == std::string("Hi\0there", 8));
+    }
+
     SUBCASE("ThrowsIfValueIsBoundToOutOfRangeIndexedParameterInPreparedStatement") {
         drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, num1 INT, num2 INT)");
         drv.prepare("INSERT INTO tbl VALUES(1, ?, ?)");
@@ -150,4 +199,147 @@ TEST_CASE("SqliteDriver") {
         REQUIRE(tables.size() == 1u);
         REQUIRE(std::find(tables.begin(), tables.end(), "tb") != tables.end());
     }    
+
+    SUBCASE("ReusesCachedStatementsWithTheSameText") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+        drv.execute("INSERT INTO tbl VALUES(1, 'abc')");
+        drv.execute("INSERT INTO tbl VALUES(2, 'cde')");
+
+        std::size_t hitCount = drv.statementCacheHitCount();
+        std::size_t missCount = drv.statementCacheMissCount();
+
+        drv.prepare("SELECT name FROM tbl WHERE id = ?");
+        drv.bindInt(1, 1);
+        drv.execute();
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "abc");
+
+        drv.prepare("SELECT name FROM tbl WHERE id = ?");
+        drv.bindInt(1, 2);
+        drv.execute();
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getStdString(0) == "cde");
+        REQUIRE_FALSE(drv.nextRow());
+
+        CHECK(drv.statementCacheMissCount() == missCount + 1);
+        CHECK(drv.statementCacheHitCount() == hitCount + 1);
+    }
+
+    SUBCASE("DoesNotKeepStatementsBindingsBetweenReuses") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+
+        drv.prepare("INSERT INTO tbl VALUES(?, ?)");
+        drv.bindInt(1, 1);
+        drv.bindStdString(2, "abc");
+        drv.execute();
+
+        drv.prepare("INSERT INTO tbl VALUES(?, ?)");
+        drv.bindInt(1, 2);
+        drv.execute();
+
+        drv.execute("SELECT name FROM tbl WHERE id = 2");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.isNull(0));
+    }
+
+    SUBCASE("EvictsLeastRecentlyUsedStatementsBeyondCapacity") {
+        drv.setStatementCacheCapacity(2);
+        CHECK(drv.statementCacheCapacity() == 2u);
+
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+        drv.execute("SELECT id FROM tbl");
+        drv.execute("SELECT name FROM tbl");
+        CHECK(drv.statementCacheSize() == 2u);
+
+        std::size_t hitCount = drv.statementCacheHitCount();
+        drv.execute("SELECT id FROM tbl");
+        CHECK(drv.statementCacheHitCount() == hitCount + 1);
+
+        drv.execute("CREATE TABLE other(id INT PRIMARY KEY)");
+        CHECK(drv.statementCacheSize() == 2u);
+
+        std::size_t missCount = drv.statementCacheMissCount();
+        drv.execute("SELECT name FROM tbl");
+        CHECK(drv.statementCacheMissCount() == missCount + 1);
+    }
+
+    SUBCASE("CompilesEveryStatementIfCacheIsDisabled") {
+        drv.setStatementCacheCapacity(0);
+
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+        drv.execute("SELECT * FROM tbl");
+        drv.execute("SELECT * FROM tbl");
+
+        CHECK(drv.statementCacheSize() == 0u);
+        CHECK(drv.statementCacheHitCount() == 0u);
+    }
+
+    SUBCASE("StepsIndependentStatementsOnTheSameConnection") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+        drv.execute("INSERT INTO tbl VALUES(1, 'abc')");
+        drv.execute("INSERT INTO tbl VALUES(2, 'cde')");
+
+        std::unique_ptr<SqlStatement> outer(drv.createStatement("SELECT id FROM tbl ORDER BY id"));
+        std::unique_ptr<SqlStatement> inner(drv.createStatement("SELECT name FROM tbl WHERE id = ?"));
+        CHECK(outer->columnCount() == 1);
+
+        std::vector<std::string> nameList;
+        outer->execute();
+        while (outer->nextRow()) {
+            inner->reset();
+            inner->bindInt(1, outer->getInt(0));
+            inner->execute();
+            REQUIRE(inner->nextRow());
+            nameList.push_back(inner->getStdString(0));
+            REQUIRE_FALSE(inner->nextRow());
+
+            drv.execute("SELECT count(*) FROM tbl");
+            REQUIRE(drv.nextRow());
+            CHECK(drv.getInt(0) == 2);
+        }
+
+        REQUIRE_FALSE(outer->nextRow());
+        REQUIRE(nameList.size() == 2u);
+        CHECK(nameList.at(0) == "abc");
+        CHECK(nameList.at(1) == "cde");
+    }
+
+    SUBCASE("GivesStatementsBackToTheCacheWhenDestroyed") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+
+        std::size_t hitCount = drv.statementCacheHitCount();
+        delete drv.createStatement("SELECT id FROM tbl");
+        delete drv.createStatement("SELECT id FROM tbl");
+
+        CHECK(drv.statementCacheHitCount() == hitCount + 1);
+    }
+
+    SUBCASE("BeginsCommitsAndRollsBackTransactions") {
+        drv.execute("CREATE TABLE tbl(id INT PRIMARY KEY, name TEXT)");
+        REQUIRE_FALSE(drv.isInTransaction());
+
+        drv.beginTransaction();
+        REQUIRE(drv.isInTransaction());
+        drv.execute("INSERT INTO tbl VALUES(1, 'abc')");
+        drv.rollback();
+        REQUIRE_FALSE(drv.isInTransaction());
+
+        drv.beginTransaction();
+        drv.execute("INSERT INTO tbl VALUES(2, 'cde')");
+        drv.setSavepoint("sp");
+        drv.execute("INSERT INTO tbl VALUES(3, 'efg')");
+        drv.rollbackToSavepoint("sp");
+        drv.releaseSavepoint("sp");
+        drv.commit();
+        REQUIRE_FALSE(drv.isInTransaction());
+
+        drv.execute("SELECT id FROM tbl");
+        REQUIRE(drv.nextRow());
+        CHECK(drv.getInt(0) == 2);
+        REQUIRE_FALSE(drv.nextRow());
+    }
+
+    SUBCASE("ThrowsIfStatementCannotBeCreated") {
+        REQUIRE_THROWS_AS(drv.createStatement("SELECT id FROM nothing"), Exception);
+    }
 }
\ No newline at end of file
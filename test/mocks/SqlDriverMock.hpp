@@ -53,6 +53,10 @@ public:
     virtual void close() {
     }
 
+    virtual SqlStatement* createStatement(const std::string& /*statement*/) {
+        return nullptr;
+    }
+
     virtual void prepare(const std::string& statement) {
     }
 
@@ -130,6 +134,10 @@ public:
     virtual void bindBlob(int column, const void* date, std::size_t size) const {
     }
 
+    virtual bool isInTransaction() const {
+        return false;
+    }
+
     virtual std::vector<std::string> tableList() {
         return std::vector<std::string>();
     }